@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "MinPlus.cpp"
+
+using namespace std;
+
+// Balas-Simonetti dynamic programming: the best tour in which a city at
+// position i of the given tour comes before every city at a position
+// j >= i + window. Such a tour changes the order only inside windows, and
+// the search is O(n * window^2 * 2^window) instead of the 2^n of Held-Karp.
+//
+// A state is the set of visited positions and the last one. If t is the
+// first position not visited yet, the positions before t are all visited
+// and none from t + window on, so the set is t and a mask S of the
+// positions t + 1 .. t + window - 1; the last position lies in
+// [t - window, t + window - 1], a slot of 2 * window. As in Held-Karp, the
+// entry of a state is the min-plus product of the entries of the state
+// without its last position with the edges into it, and the same kernels
+// compute it. Entries of the positions up to t - window - 1 are not read
+// any more, so the costs keep only window + 1 values of t; the parents
+// (one byte each) are kept for all of them to rebuild the tour.
+template <class Cost = int>
+class BasicBalasSimonetti {
+public:
+    static constexpr Cost INF = numeric_limits<Cost>::max();
+
+    // Slots have to fit into the members mask of the kernels
+    static constexpr int MAX_WINDOW = 15;
+
+    // graph[i][j] == 0 means there is no edge from i to j
+    BasicBalasSimonetti(const vector<vector<int>>& graph)
+        : n(graph.size()), graph(graph),
+          minPlus(findMinPlusFor<Cost>("auto")) {}
+
+    void setKernel(BasicMinPlusKernel<Cost> kernel) { minPlus = kernel; }
+
+    // Improve the closed tour (start ... start) with passes of the given
+    // window, rotating the tour between them so that no part of it stays
+    // at the fixed start, until two passes in a row find nothing. Returns
+    // its cost, -1 if no tour was found.
+    long long improve(vector<int>& tour, int window) {
+        if (tour.size() < 2)
+            return -1;
+        int start = tour[0];
+        vector<int> order(tour.begin(), tour.end() - 1);
+        window = min({window, MAX_WINDOW, n});
+
+        if (int(order.size()) == n && window >= 2) {
+            for (int stale = 0; stale < 2;) {
+                stale = pass(order, window) ? 0 : stale + 1;
+                rotate(order.begin(), order.begin() + n / 2, order.end());
+            }
+        }
+
+        rotate(order.begin(), find(order.begin(), order.end(), start),
+               order.end());
+        tour = order;
+        tour.push_back(start);
+
+        long long total = 0;
+        for (size_t i = 0; i + 1 < tour.size(); ++i) {
+            int weight = graph[tour[i]][tour[i + 1]];
+            if (weight <= 0)
+                return -1;
+            total += weight;
+        }
+        return total;
+    }
+
+private:
+    int n;
+    const vector<vector<int>>& graph;
+    BasicMinPlusKernel<Cost> minPlus;
+    vector<Cost> costs;
+    vector<uint8_t> parents;
+    vector<Cost> into;
+
+    Cost weight(int from, int to) const {
+        int value = graph[from][to];
+        return value > 0 ? Cost(value) : INF;
+    }
+
+    // Visited set without its last position last: first unvisited position
+    // and mask of the next ones, false if that set is not a state
+    static bool previous(int t, uint32_t mask, int last, int window,
+                         int& previousT, uint32_t& previousMask) {
+        if (last > t) {
+            previousT = t;
+            previousMask = mask & ~(1u << (last - t - 1));
+            return true;
+        }
+        int highest = mask ? t + 32 - __builtin_clz(mask) : t - 1;
+        if (highest > last + window - 1)
+            return false;
+        previousT = last;
+        previousMask = ((1u << (t - 1 - last)) - 1) | mask << (t - last);
+        return true;
+    }
+
+    // One Balas-Simonetti pass over order with order[0] fixed, true if it
+    // found a cheaper tour (and stored it in order)
+    bool pass(vector<int>& order, int window) {
+        int rows = window + 1;
+        uint32_t masks = 1u << (window - 1);
+        int slots = 2 * window;
+        size_t rowSize = size_t(masks) * slots;
+        costs.assign(rows * rowSize, INF);
+        parents.assign((n + 1) * rowSize, 0);
+        into.assign(size_t(slots) * slots, INF);
+
+        auto entry = [&](int t, uint32_t mask) {
+            return &costs[(t % rows) * rowSize + size_t(mask) * slots];
+        };
+
+        for (int t = 1; t <= n; ++t) {
+            fill(entry(t, 0), entry(t, 0) + rowSize, INF);
+
+            // into[slot * slots + k]: edge into the position of slot from
+            // the position of slot k of the previous state
+            for (int slot = 0; slot < slots; ++slot) {
+                int last = t + slot - window;
+                int previousT = last < t ? last : t;
+                for (int k = 0; k < slots; ++k) {
+                    int from = previousT + k - window;
+                    into[size_t(slot) * slots + k] =
+                        last >= 0 && last < n && from >= 0 && from < n
+                            ? weight(order[from], order[last])
+                            : INF;
+                }
+            }
+
+            for (uint32_t mask = 0; mask < masks; ++mask) {
+                if (t == n && mask != 0)
+                    break;
+                if (t < n && n - 1 - t < window - 1 &&
+                    mask >> (n - 1 - t) != 0)
+                    continue;
+                Cost* target = entry(t, mask);
+                if (t == 1 && mask == 0) {
+                    target[window - 1] = 0;  // only the start is visited
+                    continue;
+                }
+
+                for (int slot = 0; slot < slots; ++slot) {
+                    int last = t + slot - window;
+                    if (last <= 0 || last >= n || last == t ||
+                        (last > t && !(mask >> (last - t - 1) & 1)))
+                        continue;
+
+                    int previousT;
+                    uint32_t previousMask;
+                    if (!previous(t, mask, last, window, previousT,
+                                  previousMask))
+                        continue;
+
+                    // Slots of the visited positions of the previous state
+                    int low = max(previousT - window, 0);
+                    uint32_t members =
+                        (((1u << (previousT - low)) - 1) << (low - previousT +
+                                                             window)) |
+                        previousMask << (window + 1);
+
+                    int argmin;
+                    target[slot] =
+                        minPlus(entry(previousT, previousMask),
+                                &into[size_t(slot) * slots], slots, members,
+                                argmin);
+                    parents[size_t(t) * rowSize + size_t(mask) * slots +
+                            slot] = uint8_t(argmin);
+                }
+            }
+        }
+
+        // Close the tour back to the start
+        long long best = -1;
+        int bestLast = -1;
+        const Cost* closing = entry(n, 0);
+        for (int slot = 0; slot < slots; ++slot) {
+            int last = n + slot - window;
+            if (last <= 0 || last >= n || closing[slot] == INF)
+                continue;
+            Cost back = weight(order[last], order[0]);
+            if (back == INF)
+                continue;
+            long long cost = (long long)closing[slot] + back;
+            if (best == -1 || cost < best) {
+                best = cost;
+                bestLast = last;
+            }
+        }
+        if (best == -1)
+            return false;
+
+        long long current = 0;
+        for (int i = 0; i < n; ++i) {
+            int edge = graph[order[i]][order[(i + 1) % n]];
+            if (edge <= 0) {
+                current = -1;
+                break;
+            }
+            current += edge;
+        }
+        if (current != -1 && best >= current)
+            return false;
+
+        vector<int> positions;
+        int t = n, last = bestLast;
+        uint32_t mask = 0;
+        while (last != 0) {
+            positions.push_back(last);
+            int slot = last - t + window;
+            int parentSlot =
+                parents[size_t(t) * rowSize + size_t(mask) * slots + slot];
+            int previousT = t;
+            uint32_t previousMask = 0;
+            previous(t, mask, last, window, previousT, previousMask);
+            last = previousT + parentSlot - window;
+            t = previousT;
+            mask = previousMask;
+        }
+
+        vector<int> improved = {order[0]};
+        for (auto it = positions.rbegin(); it != positions.rend(); ++it)
+            improved.push_back(order[*it]);
+        order = improved;
+        return true;
+    }
+};
+
+using BalasSimonetti = BasicBalasSimonetti<>;
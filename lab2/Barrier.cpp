@@ -0,0 +1,30 @@
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+
+// Reusable barrier: wait() returns once all count threads have called it,
+// and the barrier is ready for the next round right away.
+class Barrier {
+private:
+    mutex lock;
+    condition_variable released;
+    int count;
+    int waiting = 0;
+    unsigned generation = 0;
+
+public:
+    Barrier(int count) : count(count) {}
+
+    void wait() {
+        unique_lock<mutex> guard(lock);
+        unsigned round = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+        } else {
+            released.wait(guard, [&] { return generation != round; });
+        }
+    }
+};
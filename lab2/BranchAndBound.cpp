@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// Exact TSP by Little's branch and bound on reduced cost matrices.
+// Reducing a matrix (subtracting the row minima, then the column minima)
+// gives a lower bound on every tour that uses only its finite entries.
+// A node branches on the zero entry (i, j) whose exclusion would raise the
+// bound the most: the left child takes the edge (drops row i and column j
+// and forbids the edge that would close a cycle early), the right child
+// forbids it. The search is depth-first, left child first. The right child
+// reuses the matrix of its parent, so only one matrix per taken edge is
+// alive and memory stays O(n^3). The search stops early when it runs out
+// of its node or time budget, with the best tour found so far.
+class BranchAndBound {
+public:
+    static constexpr int INF = numeric_limits<int>::max();
+
+    // graph[i][j] == 0 means there is no edge from i to j
+    BranchAndBound(const vector<vector<int>>& graph) : n(graph.size()) {
+        matrix.assign(size_t(n) * n, INF);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                if (i != j && graph[i][j] > 0)
+                    matrix[size_t(i) * n + j] = graph[i][j];
+    }
+
+    // Stop after maxNodes nodes or after the time limit
+    void setBudget(long long maxNodes, double milliseconds) {
+        nodeLimit = maxNodes;
+        timeLimit = milliseconds;
+    }
+
+    // Find the best tour that is cheaper than upperBound; tour is the
+    // known tour of that cost (0 ... 0) or empty. Returns the cost of the
+    // best tour found, INF if there is none.
+    int solve(int upperBound, const vector<int>& tour) {
+        bestCost = upperBound;
+        bestTour = tour;
+        nodes = 0;
+        stopped = false;
+        started = chrono::steady_clock::now();
+        if (n < 2)
+            return bestTour.empty() ? INF : bestCost;
+
+        Node root;
+        root.matrix = matrix;
+        root.rowDone.assign(n, false);
+        root.columnDone.assign(n, false);
+        root.next.assign(n, -1);
+        root.fragmentStart.resize(n);
+        root.fragmentEnd.resize(n);
+        for (int i = 0; i < n; ++i)
+            root.fragmentStart[i] = root.fragmentEnd[i] = i;
+        root.edges = 0;
+        root.bound = 0;
+
+        if (reduce(root))
+            explore(root);
+        return bestTour.empty() ? INF : bestCost;
+    }
+
+    // Best tour found by the last solve (0 ... 0), empty if none
+    const vector<int>& tour() const { return bestTour; }
+
+    long long nodeCount() const { return nodes; }
+
+    // Whether the last solve went through the whole tree, so that its tour
+    // is optimal, rather than stopping at the budget
+    bool complete() const { return !stopped; }
+
+private:
+    struct Node {
+        vector<int> matrix;
+        vector<bool> rowDone;
+        vector<bool> columnDone;
+        vector<int> next;           // successor of a city on a taken edge
+        vector<int> fragmentStart;  // start of the path ending in a city
+        vector<int> fragmentEnd;    // end of the path starting in a city
+        int edges;
+        long long bound;
+    };
+
+    int n;
+    vector<int> matrix;
+    int bestCost;
+    vector<int> bestTour;
+    long long nodes;
+    long long nodeLimit = numeric_limits<long long>::max();
+    double timeLimit = numeric_limits<double>::infinity();
+    chrono::steady_clock::time_point started;
+    bool stopped = false;
+
+    // Whether the budget is used up. A node takes O(n^2) work at least, so
+    // reading the clock at every one costs next to nothing.
+    bool outOfBudget() {
+        if (!stopped) {
+            chrono::duration<double, milli> elapsed =
+                chrono::steady_clock::now() - started;
+            stopped = nodes >= nodeLimit || elapsed.count() > timeLimit;
+        }
+        return stopped;
+    }
+
+    int& at(Node& node, int i, int j) const {
+        return node.matrix[size_t(i) * n + j];
+    }
+
+    // Subtract the row and column minima and add them to the bound,
+    // false if some row or column has no finite entry left
+    bool reduce(Node& node) const {
+        for (int i = 0; i < n; ++i) {
+            if (node.rowDone[i])
+                continue;
+            int least = INF;
+            for (int j = 0; j < n; ++j)
+                if (!node.columnDone[j])
+                    least = min(least, at(node, i, j));
+            if (least == INF)
+                return false;
+            if (least == 0)
+                continue;
+            for (int j = 0; j < n; ++j)
+                if (!node.columnDone[j] && at(node, i, j) != INF)
+                    at(node, i, j) -= least;
+            node.bound += least;
+        }
+
+        for (int j = 0; j < n; ++j) {
+            if (node.columnDone[j])
+                continue;
+            int least = INF;
+            for (int i = 0; i < n; ++i)
+                if (!node.rowDone[i])
+                    least = min(least, at(node, i, j));
+            if (least == INF)
+                return false;
+            if (least == 0)
+                continue;
+            for (int i = 0; i < n; ++i)
+                if (!node.rowDone[i] && at(node, i, j) != INF)
+                    at(node, i, j) -= least;
+            node.bound += least;
+        }
+        return true;
+    }
+
+    // Rise of the bound if the zero entry (i, j) is forbidden
+    long long penalty(Node& node, int i, int j) const {
+        int rowLeast = INF;
+        for (int k = 0; k < n; ++k)
+            if (k != j && !node.columnDone[k])
+                rowLeast = min(rowLeast, at(node, i, k));
+        int columnLeast = INF;
+        for (int k = 0; k < n; ++k)
+            if (k != i && !node.rowDone[k])
+                columnLeast = min(columnLeast, at(node, k, j));
+        if (rowLeast == INF || columnLeast == INF)
+            return INF;
+        return (long long)rowLeast + columnLeast;
+    }
+
+    // node is reduced and its bound is below the best cost
+    void explore(Node& node) {
+        while (node.bound < bestCost) {
+            if (outOfBudget())
+                return;
+            ++nodes;
+
+            if (node.edges == n) {
+                recordTour(node);
+                return;
+            }
+
+            int bestI = -1, bestJ = -1;
+            long long bestPenalty = -1;
+            for (int i = 0; i < n; ++i) {
+                if (node.rowDone[i])
+                    continue;
+                for (int j = 0; j < n; ++j) {
+                    if (node.columnDone[j] || at(node, i, j) != 0)
+                        continue;
+                    long long rise = penalty(node, i, j);
+                    if (rise > bestPenalty) {
+                        bestPenalty = rise;
+                        bestI = i;
+                        bestJ = j;
+                    }
+                }
+            }
+            if (bestI == -1)
+                return;
+
+            Node child = node;
+            take(child, bestI, bestJ);
+            if (reduce(child) && child.bound < bestCost)
+                explore(child);
+
+            if (bestPenalty >= INF)
+                return;
+            at(node, bestI, bestJ) = INF;
+            if (!reduce(node))
+                return;
+        }
+    }
+
+    // Take the edge i -> j into the tour
+    void take(Node& node, int i, int j) const {
+        node.rowDone[i] = true;
+        node.columnDone[j] = true;
+        node.next[i] = j;
+        ++node.edges;
+
+        int start = node.fragmentStart[i];
+        int end = node.fragmentEnd[j];
+        node.fragmentEnd[start] = end;
+        node.fragmentStart[end] = start;
+
+        // The edge back from the end of the new path to its start would
+        // close a cycle, unless it is the last edge of the tour.
+        if (node.edges < n - 1)
+            at(node, end, start) = INF;
+    }
+
+    void recordTour(const Node& node) {
+        bestCost = int(node.bound);
+        bestTour = {0};
+        for (int city = node.next[0]; city != 0; city = node.next[city])
+            bestTour.push_back(city);
+        bestTour.push_back(0);
+    }
+};
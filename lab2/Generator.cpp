@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Seeded TSP instances. Every random number is a hash of the seed, a stream
+// (what the number is for) and its position, so any row can be generated
+// on its own, in any order and on any thread, and a seed always gives the
+// same matrix. Only the points of the geometric modes (O(n)) are kept.
+//   uniform:   independent weights in [min, max]
+//   symmetric: the same, with w(i, j) = w(j, i)
+//   euclidean: rounded distances between random points in a max x max
+//              square, at least max(min, 1)
+//   clustered: the same with the points around clusters random centers
+//   sparse:    uniform, but each edge is missing (0) with probability
+//              missing
+class Generator {
+public:
+    enum Mode { UNIFORM, SYMMETRIC, EUCLIDEAN, CLUSTERED, SPARSE };
+
+    struct Settings {
+        Mode mode = UNIFORM;
+        int n = 5;
+        int min = 0;
+        int max = 100;
+        uint64_t seed = 1;
+        double missing = 0.3;  // sparse: probability of a missing edge
+        int clusters = 0;      // clustered: 0 means about one per 100 cities
+    };
+
+    Generator(const Settings& settings) : settings(settings) {
+        for (uint64_t stream = 0; stream < STREAMS; ++stream)
+            streamSeeds[stream] = mix(mix(settings.seed) ^ stream);
+        if (settings.mode == EUCLIDEAN || settings.mode == CLUSTERED)
+            placePoints();
+    }
+
+    // Mode by name, false if there is none
+    static bool findMode(const string& name, Mode& mode) {
+        const char* names[] = {"uniform", "symmetric", "euclidean",
+                               "clustered", "sparse"};
+        for (int i = 0; i < 5; ++i) {
+            if (name == names[i]) {
+                mode = Mode(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool symmetric() const {
+        return settings.mode != UNIFORM && settings.mode != SPARSE;
+    }
+
+    // Largest weight the matrix can have
+    long long largest() const {
+        if (settings.mode == EUCLIDEAN || settings.mode == CLUSTERED)
+            return max<long long>(ceil(settings.max * sqrt(2.0)),
+                                  floorWeight());
+        return settings.max;
+    }
+
+    // Row i of the matrix into values[0 .. n - 1]
+    void row(int i, int* values) const {
+        for (int j = 0; j < settings.n; ++j)
+            values[j] = i == j ? 0 : weight(i, j);
+    }
+
+private:
+    // Streams of random numbers
+    enum Stream { WEIGHT, EDGE, POINT, CENTER, CLUSTER, STREAMS };
+
+    Settings settings;
+    uint64_t streamSeeds[STREAMS];
+    vector<double> x;
+    vector<double> y;
+
+    static uint64_t mix(uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t random(Stream stream, uint64_t a, uint64_t b = 0) const {
+        return mix(mix(streamSeeds[stream] ^ a) ^ b);
+    }
+
+    // In [0, 1)
+    double unit(Stream stream, uint64_t a, uint64_t b = 0) const {
+        return (random(stream, a, b) >> 11) * 0x1p-53;
+    }
+
+    // Scales value to [low, high] with a multiplication, not a division
+    int between(uint64_t value, int low, int high) const {
+        uint64_t range = uint64_t(int64_t(high) - low) + 1;
+        return int(low + ((unsigned __int128)value * range >> 64));
+    }
+
+    int floorWeight() const { return max(settings.min, 1); }
+
+    int weight(int i, int j) const {
+        switch (settings.mode) {
+        case SYMMETRIC:
+            return between(random(WEIGHT, min(i, j), max(i, j)), settings.min,
+                           settings.max);
+        case EUCLIDEAN:
+        case CLUSTERED:
+            return max(int(sqrt((x[i] - x[j]) * (x[i] - x[j]) +
+                                (y[i] - y[j]) * (y[i] - y[j])) +
+                           0.5),
+                       floorWeight());
+        case SPARSE:
+            if (unit(EDGE, i, j) < settings.missing)
+                return 0;
+            return between(random(WEIGHT, i, j), settings.min, settings.max);
+        default:
+            return between(random(WEIGHT, i, j), settings.min, settings.max);
+        }
+    }
+
+    // Standard normal number from two uniform ones (Box-Muller)
+    double normal(Stream stream, uint64_t a, uint64_t b) const {
+        double u = 1 - unit(stream, a, 2 * b);
+        double v = unit(stream, a, 2 * b + 1);
+        return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+    }
+
+    void placePoints() {
+        int n = settings.n;
+        double side = settings.max;
+        x.resize(n);
+        y.resize(n);
+
+        if (settings.mode == EUCLIDEAN) {
+            for (int k = 0; k < n; ++k) {
+                x[k] = unit(POINT, k, 0) * side;
+                y[k] = unit(POINT, k, 1) * side;
+            }
+            return;
+        }
+
+        int clusters = settings.clusters > 0 ? settings.clusters
+                                             : max(1, n / 100);
+        double spread = side / (4 * sqrt(double(clusters)));
+        for (int k = 0; k < n; ++k) {
+            uint64_t cluster = random(CLUSTER, k) % clusters;
+            double cx = unit(CENTER, cluster, 0) * side;
+            double cy = unit(CENTER, cluster, 1) * side;
+            x[k] = min(max(cx + spread * normal(POINT, k, 0), 0.0), side);
+            y[k] = min(max(cy + spread * normal(POINT, k, 1), 0.0), side);
+        }
+    }
+};
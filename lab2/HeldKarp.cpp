@@ -0,0 +1,245 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Barrier.cpp"
+#include "MinPlus.cpp"
+
+using namespace std;
+
+// Bottom-up Held-Karp over the subsets of the cities 1..n-1.
+// City 0 starts every tour and would be in every subset, so it has no bit:
+// bit i of a mask stands for city i + 1. cost(mask, last) is the cheapest
+// path that leaves city 0, visits exactly the cities of mask and ends in
+// last. The table is one cache-aligned array, the entries of a mask stored
+// next to each other and the masks in increasing order, so every subset is
+// computed from smaller ones that are already done.
+//
+// Subsets of the same size do not depend on each other, so the parallel
+// solve goes through them layer by layer: the workers take blocks of
+// consecutive masks and fill the entries of the layer's masks in them, and
+// wait for each other before the next layer. A block is a contiguous piece
+// of the table, so no two workers write to the same cache line.
+//
+// Cost is the type of the table entries; its maximum is INF, so a smaller
+// type holds graphs whose paths all cost less than that (see fits()).
+// Parent is the type of the parent table, or void to keep no parent table
+// and find a parent again from the costs when it is asked for.
+template <class Cost = int, class Parent = uint8_t>
+class BasicHeldKarp {
+public:
+    static constexpr Cost INF = numeric_limits<Cost>::max();
+    static constexpr int NO_CITY = -1;
+    static constexpr bool STORES_PARENTS = !is_void<Parent>::value;
+
+    // graph[i][j] == 0 means there is no edge from i to j
+    BasicHeldKarp(const vector<vector<int>>& graph)
+        : n(graph.size()), m(n > 0 ? n - 1 : 0),
+          minPlus(findMinPlusFor<Cost>("auto")) {
+        weight.assign(size_t(m) * m, INF);
+        fromStart.assign(m, INF);
+        toStart.assign(m, INF);
+
+        for (int i = 0; i < m; ++i) {
+            if (graph[0][i + 1] > 0)
+                fromStart[i] = graph[0][i + 1];
+            if (graph[i + 1][0] > 0)
+                toStart[i] = graph[i + 1][0];
+            for (int j = 0; j < m; ++j)
+                if (i != j && graph[i + 1][j + 1] > 0)
+                    weight[size_t(j) * m + i] = graph[i + 1][j + 1];
+        }
+    }
+
+    // Whether every path of graph costs less than INF, which the table
+    // needs; a path leaves each city at most once
+    static bool fits(const vector<vector<int>>& graph) {
+        unsigned long long bound = 0;
+        for (const vector<int>& row : graph) {
+            int heaviest = 0;
+            for (int weight : row)
+                heaviest = max(heaviest, weight);
+            bound += heaviest;
+        }
+        return bound < (unsigned long long)INF;
+    }
+
+    void setKernel(BasicMinPlusKernel<Cost> kernel) { minPlus = kernel; }
+
+    // Fill the table on threadCount threads, returns the cost of the best
+    // tour or INF if there is no tour at all
+    Cost solve(int threadCount = 1) {
+        if (m == 0)
+            return INF;
+
+        size_t entries = (size_t(1) << m) * m;
+        costs = allocate<Cost>(entries);
+        for (size_t i = 0; i < entries; ++i)
+            costs[i] = INF;
+        if (STORES_PARENTS) {
+            parents = allocate<ParentEntry>(entries);
+            for (size_t i = 0; i < entries; ++i)
+                parents[i] = 0;
+        }
+
+        for (int j = 0; j < m; ++j)
+            costs[index(1u << j, j)] = fromStart[j];
+
+        if (threadCount <= 1) {
+            for (uint32_t mask = 1; mask < (1u << m); ++mask) {
+                if (mask & (mask - 1))
+                    relax(mask);
+            }
+        } else {
+            solveLayers(threadCount);
+        }
+
+        uint32_t full = (1u << m) - 1;
+        tourCost = INF;
+        tourLast = NO_CITY;
+        for (int k = 0; k < m; ++k) {
+            Cost pathCost = costs[index(full, k)];
+            if (pathCost == INF || toStart[k] >= INF - pathCost)
+                continue;
+            if (Cost(pathCost + toStart[k]) < tourCost) {
+                tourCost = pathCost + toStart[k];
+                tourLast = k + 1;
+            }
+        }
+        return tourCost;
+    }
+
+    // Masks and cities below use the numbering of the graph: bit c of a
+    // mask is city c, and bit 0 (the start) may be set or not.
+
+    // Cost of the best path from 0 through the cities of mask ending in last
+    Cost cost(uint32_t mask, int last) const {
+        return costs[index(mask >> 1 & fullMask(), last - 1)];
+    }
+
+    // City before last on that path (0 for the first city of a path).
+    // Without a parent table this repeats the min-plus step of the entry,
+    // which finds the same parent as the solve did.
+    int parent(uint32_t mask, int last) const {
+        uint32_t inner = mask >> 1 & fullMask();
+        if (STORES_PARENTS)
+            return parents[index(inner, last - 1)];
+
+        uint32_t previous = inner ^ (1u << (last - 1));
+        if (previous == 0)
+            return 0;
+        int argmin;
+        minPlus(&costs[index(previous, 0)], &weight[size_t(last - 1) * m], m,
+                previous, argmin);
+        return argmin + 1;
+    }
+
+    // Last city of the best tour before it returns to 0
+    int lastCity() const { return tourLast; }
+
+    // Bytes the table of an n-city graph takes
+    static size_t memoryFor(int n) {
+        if (n < 2)
+            return 0;
+        size_t entryBytes =
+            sizeof(Cost) + (STORES_PARENTS ? sizeof(ParentEntry) : 0);
+        return (size_t(1) << (n - 1)) * (n - 1) * entryBytes;
+    }
+
+    // Largest graph the masks can describe
+    static constexpr int MAX_CITIES = 31;
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Masks in one block of the parallel solve
+    static constexpr uint32_t BLOCK = 1024;
+
+    // Parents are stored as cities of the graph, 0 for the start
+    typedef conditional_t<is_void<Parent>::value, uint8_t, Parent>
+        ParentEntry;
+
+    struct FreeMemory {
+        void operator()(void* data) const { free(data); }
+    };
+
+    int n;
+    int m;
+    vector<Cost> weight;  // weight[j * m + k]: edge k + 1 -> j + 1
+    vector<Cost> fromStart;
+    vector<Cost> toStart;
+    BasicMinPlusKernel<Cost> minPlus;
+    unique_ptr<Cost[], FreeMemory> costs;
+    unique_ptr<ParentEntry[], FreeMemory> parents;
+    Cost tourCost = INF;
+    int tourLast = NO_CITY;
+
+    uint32_t fullMask() const { return (1u << m) - 1; }
+
+    // Fill the entries of mask from the subsets one city smaller
+    void relax(uint32_t mask) {
+        for (uint32_t rest = mask; rest; rest &= rest - 1) {
+            int last = __builtin_ctz(rest);
+            uint32_t previous = mask ^ (1u << last);
+            const Cost* row = &costs[index(previous, 0)];
+            const Cost* into = &weight[size_t(last) * m];
+
+            int bestParent;
+            Cost best = minPlus(row, into, m, previous, bestParent);
+
+            costs[index(mask, last)] = best;
+            if (STORES_PARENTS)
+                parents[index(mask, last)] = ParentEntry(bestParent + 1);
+        }
+    }
+
+    void solveLayers(int threadCount) {
+        uint32_t blocks = ((1u << m) + BLOCK - 1) / BLOCK;
+        vector<atomic<uint32_t>> nextBlock(m + 1);
+        for (auto& block : nextBlock)
+            block.store(0);
+        Barrier barrier(threadCount);
+
+        auto work = [&]() {
+            for (int layer = 2; layer <= m; ++layer) {
+                uint32_t block;
+                while ((block = nextBlock[layer].fetch_add(1)) < blocks) {
+                    uint32_t first = block * BLOCK;
+                    uint32_t last = min(first + BLOCK, 1u << m);
+                    for (uint32_t mask = first; mask < last; ++mask) {
+                        if (__builtin_popcount(mask) == layer)
+                            relax(mask);
+                    }
+                }
+                barrier.wait();
+            }
+        };
+
+        vector<thread> workers;
+        for (int i = 1; i < threadCount; ++i)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    size_t index(uint32_t mask, int last) const {
+        return size_t(mask) * m + last;
+    }
+
+    template <class Entry>
+    static unique_ptr<Entry[], FreeMemory> allocate(size_t entries) {
+        size_t bytes = (entries * sizeof(Entry) + CACHE_LINE - 1) /
+                       CACHE_LINE * CACHE_LINE;
+        Entry* data = static_cast<Entry*>(aligned_alloc(CACHE_LINE, bytes));
+        if (data == nullptr)
+            throw bad_alloc();
+        return unique_ptr<Entry[], FreeMemory>(data);
+    }
+};
+
+using HeldKarp = BasicHeldKarp<>;
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// Local search that shortens a closed tour with three kinds of moves:
+//   2-opt: replace a -> b and c -> d by a -> c and b -> d, which reverses
+//          the path b ... c. With asymmetric costs the reversed path costs
+//          something else, and prefix sums of the tour in both directions
+//          give that cost in O(1).
+//   Or-opt: move a path of 1 to 3 cities between two other neighbours,
+//           keeping its direction, so it is valid for any costs.
+//   or-3opt: swap two neighbouring paths b ... c and d ... e (the 3-opt
+//            move that keeps every path's direction).
+// Only the candidateCount cheapest edges out of (2-opt, or-3opt) and into
+// (Or-opt, or-3opt) a city are tried, and a city whose moves all failed is
+// not looked at again until one of its tour edges changes (don't-look
+// bits), so looking for moves stays close to linear in n. Making a move
+// costs O(n) more: the positions and prefix sums are rebuilt from the
+// first changed position on.
+class LocalSearch {
+public:
+    // graph[i][j] == 0 means there is no edge from i to j
+    LocalSearch(const vector<vector<int>>& graph, int candidateCount = 8)
+        : n(graph.size()) {
+        costs.assign(size_t(n) * n, MISSING);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                if (i != j && graph[i][j] > 0)
+                    costs[size_t(i) * n + j] = graph[i][j];
+
+        successors.resize(n);
+        predecessors.resize(n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (cost(i, j) < MISSING)
+                    successors[i].push_back(j);
+                if (cost(j, i) < MISSING)
+                    predecessors[i].push_back(j);
+            }
+            keepCheapest(successors[i], candidateCount,
+                         [&](int j) { return cost(i, j); });
+            keepCheapest(predecessors[i], candidateCount,
+                         [&](int j) { return cost(j, i); });
+        }
+    }
+
+    // Stop after maxMoves improving moves or after the time limit
+    void setBudget(long long maxMoves, double milliseconds) {
+        moveLimit = maxMoves;
+        timeLimit = milliseconds;
+    }
+
+    // Improve the closed tour (start ... start) in place, returns its cost
+    // or -1 if it uses a missing edge
+    long long improve(vector<int>& tour) {
+        moves = 0;
+        if (tour.size() < 2)
+            return -1;
+
+        int start = tour[0];
+        order.assign(tour.begin(), tour.end() - 1);
+
+        if (int(order.size()) == n && n >= 5) {
+            refresh();
+            search();
+        }
+
+        rotate(order.begin(), find(order.begin(), order.end(), start),
+               order.end());
+        tour = order;
+        tour.push_back(start);
+
+        long long total = 0;
+        for (size_t i = 0; i + 1 < tour.size(); ++i)
+            total += cost(tour[i], tour[i + 1]);
+        return total >= MISSING ? -1 : total;
+    }
+
+    long long moveCount() const { return moves; }
+
+private:
+    // Cost of a missing edge: more than any tour, and n of them still fit
+    static constexpr long long MISSING = 1LL << 40;
+
+    int n;
+    vector<long long> costs;
+    vector<vector<int>> successors;    // cheapest edges out of a city
+    vector<vector<int>> predecessors;  // cheapest edges into a city
+    long long moveLimit = numeric_limits<long long>::max();
+    double timeLimit = numeric_limits<double>::infinity();
+    long long moves = 0;
+
+    vector<int> order;     // the tour without its closing city
+    vector<int> position;  // index of a city in order
+    vector<long long> forward;   // cost of order[0 .. k]
+    vector<long long> backward;  // cost of order[k .. 0]
+    vector<bool> active;
+    deque<int> queue;
+
+    long long cost(int i, int j) const { return costs[size_t(i) * n + j]; }
+
+    // Sorts only the count cheapest cities, O(n log count) per city
+    template <class Cost>
+    static void keepCheapest(vector<int>& cities, int count, Cost byCost) {
+        auto cheaper = [&](int a, int b) {
+            return byCost(a) < byCost(b) || (byCost(a) == byCost(b) && a < b);
+        };
+        if (int(cities.size()) > count) {
+            partial_sort(cities.begin(), cities.begin() + count, cities.end(),
+                         cheaper);
+            cities.resize(count);
+        } else {
+            sort(cities.begin(), cities.end(), cheaper);
+        }
+    }
+
+    // Positions and prefix sums of order[from ..]
+    void refresh(int from = 0) {
+        position.resize(n);
+        forward.resize(n);
+        backward.resize(n);
+        forward[0] = backward[0] = 0;
+        for (int k = from; k < n; ++k) {
+            position[order[k]] = k;
+            if (k > 0) {
+                forward[k] = forward[k - 1] + cost(order[k - 1], order[k]);
+                backward[k] = backward[k - 1] + cost(order[k], order[k - 1]);
+            }
+        }
+    }
+
+    void activate(int city) {
+        if (!active[city]) {
+            active[city] = true;
+            queue.push_back(city);
+        }
+    }
+
+    void search() {
+        auto started = chrono::steady_clock::now();
+        active.assign(n, true);
+        queue.assign(order.begin(), order.end());
+
+        while (!queue.empty() && moves < moveLimit) {
+            chrono::duration<double, milli> elapsed =
+                chrono::steady_clock::now() - started;
+            if (elapsed.count() > timeLimit)
+                break;
+
+            int city = queue.front();
+            queue.pop_front();
+            active[city] = false;
+
+            if (twoOpt(city) || orOpt(city) || swapPaths(city)) {
+                ++moves;
+                activate(city);
+            }
+        }
+    }
+
+    int next(int k) const { return order[k + 1 == n ? 0 : k + 1]; }
+
+    bool twoOpt(int a) {
+        int i = position[a];
+        if (i == n - 1)
+            return false;
+        int b = order[i + 1];
+
+        for (int c : successors[a]) {
+            if (cost(a, c) >= cost(a, b))
+                break;
+            int j = position[c];
+            if (j <= i + 1)
+                continue;
+            int d = next(j);
+
+            long long delta = cost(a, c) + cost(b, d) - cost(a, b) -
+                              cost(c, d) + (backward[j] - backward[i + 1]) -
+                              (forward[j] - forward[i + 1]);
+            if (delta < 0) {
+                reverse(order.begin() + i + 1, order.begin() + j + 1);
+                refresh(i + 1);
+                activate(b);
+                activate(c);
+                activate(d);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // a -> b ... c -> d ... e -> f becomes a -> d ... e -> b ... c -> f
+    bool swapPaths(int a) {
+        int i = position[a];
+        if (i == n - 1)
+            return false;
+        int b = order[i + 1];
+
+        for (int d : successors[a]) {
+            if (cost(a, d) >= cost(a, b))
+                break;
+            int j = position[d];
+            if (j <= i + 1)
+                continue;
+            int c = order[j - 1];
+
+            for (int e : predecessors[b]) {
+                int k = position[e];
+                if (k < j)
+                    continue;
+                int f = next(k);
+
+                long long delta = cost(a, d) + cost(e, b) + cost(c, f) -
+                                  cost(a, b) - cost(c, d) - cost(e, f);
+                if (delta < 0) {
+                    rotate(order.begin() + i + 1, order.begin() + j,
+                           order.begin() + k + 1);
+                    refresh(i + 1);
+                    activate(b);
+                    activate(c);
+                    activate(d);
+                    activate(e);
+                    activate(f);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool orOpt(int first) {
+        int i = position[first];
+
+        for (int length = 1; length <= 3 && i + length <= n && length <= n - 3;
+             ++length) {
+            int last = order[i + length - 1];
+            int p = order[i == 0 ? n - 1 : i - 1];
+            int q = next(i + length - 1);
+            long long removed = cost(p, first) + cost(last, q) - cost(p, q);
+
+            for (int c : predecessors[first]) {
+                if (cost(c, first) >= removed)
+                    break;
+                int k = position[c];
+                if (c == p || (k >= i && k < i + length))
+                    continue;
+                int d = next(k);
+
+                long long delta =
+                    cost(c, first) + cost(last, d) - cost(c, d) - removed;
+                if (delta < 0) {
+                    vector<int> path(order.begin() + i,
+                                     order.begin() + i + length);
+                    order.erase(order.begin() + i, order.begin() + i + length);
+                    int at = k > i ? k - length : k;
+                    order.insert(order.begin() + at + 1, path.begin(),
+                                 path.end());
+                    refresh(min(i, at + 1));
+                    activate(p);
+                    activate(q);
+                    activate(c);
+                    activate(d);
+                    activate(last);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
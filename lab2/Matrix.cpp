@@ -0,0 +1,274 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+// Matrix files of the TSP, text or binary.
+// Text: n, then the n rows of n integers, separated by whitespace.
+// Binary: a MatrixHeader, then the entries as little-endian elements of the
+// header's type, row by row. A symmetric matrix stores only the entries
+// above the diagonal (row i from column i + 1 on), the diagonal is 0.
+// Readers tell the formats apart by the magic at the start.
+enum MatrixElement : uint8_t {
+    ELEMENT_UINT8 = 1,   // the value is the size of an element in bytes
+    ELEMENT_UINT16 = 2,
+    ELEMENT_INT32 = 4,
+};
+
+struct MatrixHeader {
+    char magic[4];       // MATRIX_MAGIC
+    uint32_t n;
+    uint8_t element;     // MatrixElement
+    uint8_t symmetric;   // 1 if only the upper triangle is stored
+    uint8_t reserved[6];
+};
+
+static_assert(sizeof(MatrixHeader) == 16, "the header is read in place");
+
+const char MATRIX_MAGIC[4] = {'T', 'S', 'P', 'M'};
+
+// Smallest element type that holds every value in [0, largest]
+MatrixElement elementFor(long long largest) {
+    if (largest <= UINT8_MAX)
+        return ELEMENT_UINT8;
+    if (largest <= UINT16_MAX)
+        return ELEMENT_UINT16;
+    return ELEMENT_INT32;
+}
+
+// Decode a binary matrix from data, false if it is malformed
+bool decodeBinaryMatrix(const char* data, size_t size,
+                        vector<vector<int>>& graph) {
+    MatrixHeader header;
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, MATRIX_MAGIC, sizeof(MATRIX_MAGIC)) != 0)
+        return false;
+    int width = header.element;
+    if (width != ELEMENT_UINT8 && width != ELEMENT_UINT16 &&
+        width != ELEMENT_INT32)
+        return false;
+
+    size_t n = header.n;
+    size_t entries = header.symmetric ? n * (n - (n > 0)) / 2 : n * n;
+    if ((size - sizeof(header)) / width < entries)
+        return false;
+
+    const char* at = data + sizeof(header);
+    auto next = [&]() {
+        int value;
+        if (width == ELEMENT_UINT8) {
+            value = uint8_t(*at);
+        } else if (width == ELEMENT_UINT16) {
+            uint16_t element;
+            memcpy(&element, at, sizeof(element));
+            value = element;
+        } else {
+            int32_t element;
+            memcpy(&element, at, sizeof(element));
+            value = element;
+        }
+        at += width;
+        return value;
+    };
+
+    graph.assign(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = header.symmetric ? i + 1 : 0; j < n; ++j) {
+            graph[i][j] = next();
+            if (header.symmetric)
+                graph[j][i] = graph[i][j];
+        }
+    }
+    return true;
+}
+
+// Parse a text matrix from data, false if it ends early or a number does
+// not fit into int. Only the characters of decimal integers matter, the
+// rest separates them.
+bool parseTextMatrix(const char* data, size_t size,
+                     vector<vector<int>>& graph) {
+    const char* at = data;
+    const char* end = data + size;
+    auto next = [&](long long& value) {
+        while (at < end && !(*at >= '0' && *at <= '9') && *at != '-')
+            ++at;
+        bool negative = at < end && *at == '-';
+        if (negative)
+            ++at;
+        if (at == end || !(*at >= '0' && *at <= '9'))
+            return false;
+        // Any int is at most 2^31 in magnitude, so value never overflows
+        value = 0;
+        for (; at < end && *at >= '0' && *at <= '9'; ++at) {
+            value = value * 10 + (*at - '0');
+            if (value > 1LL << 31)
+                return false;
+        }
+        if (negative)
+            value = -value;
+        return value >= INT32_MIN && value <= INT32_MAX;
+    };
+
+    // Every entry takes a digit and a separator (but the last), so the
+    // rest of the data bounds n before the rows are allocated
+    long long n;
+    if (!next(n) || n < 0)
+        return false;
+    size_t rest = end - at;
+    if (n > 0 && size_t(n) > (rest + 1) / 2 / size_t(n))
+        return false;
+
+    graph.assign(n, vector<int>(n, 0));
+    for (long long i = 0; i < n; ++i) {
+        for (long long j = 0; j < n; ++j) {
+            long long value;
+            if (!next(value))
+                return false;
+            graph[i][j] = int(value);
+        }
+    }
+    return true;
+}
+
+bool decodeMatrix(const char* data, size_t size, vector<vector<int>>& graph) {
+    if (size >= sizeof(MATRIX_MAGIC) &&
+        memcmp(data, MATRIX_MAGIC, sizeof(MATRIX_MAGIC)) == 0)
+        return decodeBinaryMatrix(data, size, graph);
+    return parseTextMatrix(data, size, graph);
+}
+
+// Read a matrix in either format from the file at path, or from stdin if
+// path is empty or "-". A file is mapped into memory and decoded from the
+// mapping, without copying it into a buffer first.
+bool readMatrix(const string& path, vector<vector<int>>& graph) {
+    if (path.empty() || path == "-") {
+        vector<char> data;
+        size_t length = 0;
+        data.resize(1 << 16);
+        size_t got;
+        while ((got = fread(&data[length], 1, data.size() - length,
+                            stdin)) > 0) {
+            length += got;
+            if (length == data.size())
+                data.resize(data.size() * 2);
+        }
+        return decodeMatrix(data.data(), length, graph);
+    }
+
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0) {
+        close(file);
+        return false;
+    }
+    size_t size = status.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+        return false;
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    bool read = decodeMatrix(static_cast<const char*>(mapping), size, graph);
+    munmap(mapping, size);
+    return read;
+}
+
+// Writes a matrix row by row, text or binary, through a large buffer that
+// goes to the file in bulk writes. A symmetric binary matrix takes only the
+// part of each row above the diagonal.
+class MatrixWriter {
+public:
+    MatrixWriter(FILE* file, int n, bool binary,
+                 MatrixElement element = ELEMENT_INT32, bool symmetric = false)
+        : file(file), n(n), binary(binary), element(element),
+          symmetric(binary && symmetric) {
+        buffer.reserve(BUFFER_SIZE + 64);
+        if (binary) {
+            MatrixHeader header = {};
+            memcpy(header.magic, MATRIX_MAGIC, sizeof(MATRIX_MAGIC));
+            header.n = n;
+            header.element = element;
+            header.symmetric = this->symmetric;
+            append(&header, sizeof(header));
+        } else {
+            appendNumber(n);
+            buffer.push_back('\n');
+        }
+    }
+
+    ~MatrixWriter() { flush(); }
+
+    // Row i of the matrix, n values
+    void writeRow(int i, const int* row) {
+        for (int j = symmetric ? i + 1 : 0; j < n; ++j) {
+            if (!binary) {
+                appendNumber(row[j]);
+                buffer.push_back(' ');
+            } else if (element == ELEMENT_UINT8) {
+                uint8_t value = row[j];
+                append(&value, sizeof(value));
+            } else if (element == ELEMENT_UINT16) {
+                uint16_t value = row[j];
+                append(&value, sizeof(value));
+            } else {
+                int32_t value = row[j];
+                append(&value, sizeof(value));
+            }
+        }
+        if (!binary)
+            buffer.push_back('\n');
+        if (buffer.size() >= BUFFER_SIZE)
+            flush();
+    }
+
+    // Write out the buffer, false if the file failed now or before
+    bool flush() {
+        if (!buffer.empty() &&
+            fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+            failed = true;
+        buffer.clear();
+        return !failed && fflush(file) == 0;
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    FILE* file;
+    int n;
+    bool binary;
+    MatrixElement element;
+    bool symmetric;
+    vector<char> buffer;
+    bool failed = false;
+
+    void append(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    void appendNumber(long long value) {
+        char digits[24];
+        int length = 0;
+        bool negative = value < 0;
+        unsigned long long rest = negative ? -(unsigned long long)value : value;
+        do {
+            digits[length++] = char('0' + rest % 10);
+            rest /= 10;
+        } while (rest > 0);
+        if (negative)
+            buffer.push_back('-');
+        while (length > 0)
+            buffer.push_back(digits[--length]);
+    }
+};
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+// The vector kernels exist only on x86; elsewhere the scalar ones are all
+#if defined(__x86_64__) || defined(__i386__)
+#define MIN_PLUS_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Min-plus step of Held-Karp: the smallest row[k] + into[k] over k < count
+// and the first k that reaches it. INF stands for a missing path or edge
+// and absorbs everything added to it. Both terms are at most INF, so their
+// sum fits into an unsigned int, and the kernels saturate it with an
+// unsigned min against INF instead of branching on the sentinels.
+// members has bit k set for the k where row[k] may be finite, the other
+// entries of row are INF. The scalar kernel walks only those bits, the
+// vector ones read the whole row.
+// Returns the minimum (INF if every term is INF), argmin is -1 then.
+// The kernels below work on int costs with INF = INT_MAX; the ones for the
+// other cost types (INF = their maximum) follow them.
+template <class Cost>
+using BasicMinPlusKernel = Cost (*)(const Cost* row, const Cost* into,
+                                    int count, uint32_t members, int& argmin);
+
+typedef BasicMinPlusKernel<int> MinPlusKernel;
+
+const int MIN_PLUS_INF = numeric_limits<int>::max();
+
+int minPlusScalar(const int* row, const int* into, int, uint32_t members,
+                  int& argmin) {
+    int best = MIN_PLUS_INF;
+    argmin = -1;
+    for (uint32_t bits = members; bits; bits &= bits - 1) {
+        int k = __builtin_ctz(bits);
+        uint32_t sum = uint32_t(row[k]) + uint32_t(into[k]);
+        if (sum < uint32_t(best)) {
+            best = int(sum);
+            argmin = k;
+        }
+    }
+    return best;
+}
+
+#ifdef MIN_PLUS_X86
+__attribute__((target("avx2"))) int minPlusAvx2(const int* row,
+                                                const int* into, int count,
+                                                uint32_t, int& argmin) {
+    const __m256i inf = _mm256_set1_epi32(MIN_PLUS_INF);
+    __m256i best = inf;
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i sum = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(into + k)));
+        best = _mm256_min_epu32(best, sum);
+    }
+
+    __m128i half = _mm_min_epu32(_mm256_castsi256_si128(best),
+                                 _mm256_extracti128_si256(best, 1));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, 0x4e));
+    half = _mm_min_epu32(half, _mm_shuffle_epi32(half, 0xb1));
+    uint32_t minimum = min(uint32_t(_mm_cvtsi128_si32(half)),
+                           uint32_t(MIN_PLUS_INF));
+
+    for (int tail = k; tail < count; ++tail)
+        minimum = min(minimum, uint32_t(row[tail]) + uint32_t(into[tail]));
+
+    argmin = -1;
+    if (minimum >= uint32_t(MIN_PLUS_INF))
+        return MIN_PLUS_INF;
+
+    const __m256i target = _mm256_set1_epi32(int(minimum));
+    for (k = 0; k + 8 <= count; k += 8) {
+        __m256i sum = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(into + k)));
+        int hits = _mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, target)));
+        if (hits) {
+            argmin = k + __builtin_ctz(hits);
+            return int(minimum);
+        }
+    }
+    for (; k < count; ++k) {
+        if (uint32_t(row[k]) + uint32_t(into[k]) == minimum) {
+            argmin = k;
+            break;
+        }
+    }
+    return int(minimum);
+}
+
+// GCC 12 reports its own AVX-512 headers as reading uninitialized values
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f"))) int minPlusAvx512(const int* row,
+                                                     const int* into,
+                                                     int count, uint32_t,
+                                                     int& argmin) {
+    const __m512i inf = _mm512_set1_epi32(MIN_PLUS_INF);
+    __m512i best = inf;
+    for (int k = 0; k < count; k += 16) {
+        __mmask16 lanes = count - k >= 16 ? 0xffff : (1u << (count - k)) - 1;
+        __m512i sum = _mm512_add_epi32(
+            _mm512_mask_loadu_epi32(inf, lanes, row + k),
+            _mm512_mask_loadu_epi32(inf, lanes, into + k));
+        best = _mm512_min_epu32(best, sum);
+    }
+
+    uint32_t minimum = _mm512_reduce_min_epu32(best);
+    argmin = -1;
+    if (minimum >= uint32_t(MIN_PLUS_INF))
+        return MIN_PLUS_INF;
+
+    const __m512i target = _mm512_set1_epi32(int(minimum));
+    for (int k = 0; k < count; k += 16) {
+        __mmask16 lanes = count - k >= 16 ? 0xffff : (1u << (count - k)) - 1;
+        __m512i sum = _mm512_add_epi32(
+            _mm512_mask_loadu_epi32(inf, lanes, row + k),
+            _mm512_mask_loadu_epi32(inf, lanes, into + k));
+        __mmask16 hits = _mm512_mask_cmpeq_epi32_mask(lanes, sum, target);
+        if (hits) {
+            argmin = k + __builtin_ctz(hits);
+            break;
+        }
+    }
+    return int(minimum);
+}
+#pragma GCC diagnostic pop
+#endif
+
+// Kernel by name (scalar, avx2, avx512), the widest one the processor
+// supports for "auto", null if the name is unknown or not supported
+MinPlusKernel findMinPlus(const string& name) {
+#ifdef MIN_PLUS_X86
+    __builtin_cpu_init();
+    bool avx512 = __builtin_cpu_supports("avx512f");
+    bool avx2 = __builtin_cpu_supports("avx2");
+
+    if (name == "avx512" || (name == "auto" && avx512))
+        return avx512 ? minPlusAvx512 : nullptr;
+    if (name == "avx2" || (name == "auto" && avx2))
+        return avx2 ? minPlusAvx2 : nullptr;
+#endif
+    if (name == "scalar" || name == "auto")
+        return minPlusScalar;
+    return nullptr;
+}
+
+// Scalar kernel for any cost type. A sum of two finite costs may not fit
+// into Cost, so it compares row[k] against best - into[k] instead.
+template <class Cost>
+Cost minPlusChecked(const Cost* row, const Cost* into, int, uint32_t members,
+                    int& argmin) {
+    const Cost inf = numeric_limits<Cost>::max();
+    Cost best = inf;
+    argmin = -1;
+    for (uint32_t bits = members; bits; bits &= bits - 1) {
+        int k = __builtin_ctz(bits);
+        if (into[k] >= best || row[k] >= best - into[k])
+            continue;
+        best = row[k] + into[k];
+        argmin = k;
+    }
+    return best;
+}
+
+#ifdef MIN_PLUS_X86
+// 16-bit costs saturate at INF = 65535 by themselves, and a vector holds
+// sixteen of them
+__attribute__((target("avx2"))) uint16_t minPlusAvx2U16(const uint16_t* row,
+                                                        const uint16_t* into,
+                                                        int count, uint32_t,
+                                                        int& argmin) {
+    __m256i best = _mm256_set1_epi16(-1);
+    int k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m256i sum = _mm256_adds_epu16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(into + k)));
+        best = _mm256_min_epu16(best, sum);
+    }
+
+    __m128i half = _mm_min_epu16(_mm256_castsi256_si128(best),
+                                 _mm256_extracti128_si256(best, 1));
+    uint16_t minimum = uint16_t(_mm_cvtsi128_si32(_mm_minpos_epu16(half)));
+    for (int tail = k; tail < count; ++tail) {
+        unsigned sum = unsigned(row[tail]) + into[tail];
+        minimum = uint16_t(min(unsigned(minimum), sum));
+    }
+
+    argmin = -1;
+    if (minimum == UINT16_MAX)
+        return minimum;
+
+    const __m256i target = _mm256_set1_epi16(short(minimum));
+    for (k = 0; k + 16 <= count; k += 16) {
+        __m256i sum = _mm256_adds_epu16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(into + k)));
+        int hits = _mm256_movemask_epi8(_mm256_cmpeq_epi16(sum, target));
+        if (hits) {
+            argmin = k + __builtin_ctz(hits) / 2;
+            return minimum;
+        }
+    }
+    for (; k < count; ++k) {
+        if (unsigned(row[k]) + into[k] == minimum) {
+            argmin = k;
+            break;
+        }
+    }
+    return minimum;
+}
+#endif
+
+// Kernel for the cost type by name, as findMinPlus; int uses the kernels
+// above, 16-bit costs have scalar and avx2, the others only scalar
+template <class Cost>
+BasicMinPlusKernel<Cost> findMinPlusFor(const string& name) {
+    if constexpr (is_same<Cost, int>::value) {
+        return findMinPlus(name);
+    }
+#ifdef MIN_PLUS_X86
+    if constexpr (is_same<Cost, uint16_t>::value) {
+        __builtin_cpu_init();
+        bool avx2 = __builtin_cpu_supports("avx2");
+        if (name == "avx2" || (name == "auto" && avx2))
+            return avx2 ? minPlusAvx2U16 : nullptr;
+    }
+#endif
+    if (name == "scalar" || name == "auto")
+        return minPlusChecked<Cost>;
+    return nullptr;
+}
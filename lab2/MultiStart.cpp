@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Nearest-neighbour construction from every start city, and optionally
+// randomized runs that now and then take the second or third cheapest next
+// city instead of the cheapest, spread over threads. Every run is
+// independent and its random numbers come from its own index, so the result
+// does not depend on the thread count.
+class MultiStart {
+public:
+    struct Result {
+        long long cost = -1;  // cost of the best tour, -1 if none
+        vector<int> tour;     // best tour, rotated to start at city 0
+        // Tour cost of every start city and of every randomized run, -1 for
+        // a run without a tour
+        vector<long long> startCosts;
+        vector<long long> randomCosts;
+    };
+
+    // Randomized runs choose among this many cheapest next cities, and
+    // pass over each one with probability 1 / SKIP_ODDS
+    static constexpr int RANDOM_CHOICES = 3;
+    static constexpr int SKIP_ODDS = 4;
+
+    // graph[i][j] == 0 means there is no edge from i to j
+    MultiStart(const vector<vector<int>>& graph)
+        : n(graph.size()), graph(graph) {}
+
+    Result run(int threadCount, int randomizedRuns, unsigned seed = 1) {
+        int runs = n + randomizedRuns;
+        vector<long long> costs(runs, -1);
+        vector<vector<int>> bestTours(max(threadCount, 1));
+        vector<int> bestRuns(bestTours.size(), -1);
+        atomic<int> nextRun(0);
+
+        auto work = [&](int worker) {
+            vector<int> tour;
+            int run;
+            while ((run = nextRun.fetch_add(1)) < runs) {
+                long long cost;
+                if (run < n) {
+                    cost = construct(run, nullptr, tour);
+                } else {
+                    mt19937 random(seed + run);
+                    cost = construct(random() % n, &random, tour);
+                }
+                costs[run] = cost;
+
+                int& best = bestRuns[worker];
+                if (cost != -1 && (best == -1 || cost < costs[best])) {
+                    best = run;
+                    bestTours[worker] = tour;
+                }
+            }
+        };
+
+        vector<thread> workers;
+        for (int i = 1; i < threadCount; ++i)
+            workers.emplace_back(work, i);
+        work(0);
+        for (auto& worker : workers)
+            worker.join();
+
+        Result result;
+        int best = -1;
+        for (size_t worker = 0; worker < bestRuns.size(); ++worker) {
+            int run = bestRuns[worker];
+            if (run == -1)
+                continue;
+            if (best == -1 || costs[run] < costs[best] ||
+                (costs[run] == costs[best] && run < best)) {
+                best = run;
+                result.tour = bestTours[worker];
+            }
+        }
+
+        if (best != -1) {
+            result.cost = costs[best];
+            rotate(result.tour.begin(),
+                   find(result.tour.begin(), result.tour.end(), 0),
+                   result.tour.end());
+            result.tour.push_back(0);
+        }
+        result.startCosts.assign(costs.begin(), costs.begin() + n);
+        result.randomCosts.assign(costs.begin() + n, costs.end());
+        return result;
+    }
+
+private:
+    int n;
+    const vector<vector<int>>& graph;
+
+    // Build a tour from start into tour (without the closing city), choosing
+    // at random among the cheapest next cities if random is given.
+    // Returns its cost, -1 if the construction got stuck.
+    long long construct(int start, mt19937* random, vector<int>& tour) const {
+        vector<bool> visited(n, false);
+        tour.assign(1, start);
+        visited[start] = true;
+        long long cost = 0;
+        int current = start;
+
+        for (int step = 1; step < n; ++step) {
+            int choices[RANDOM_CHOICES];
+            int count = 0;
+            int limit = random != nullptr ? RANDOM_CHOICES : 1;
+
+            for (int i = 0; i < n; ++i) {
+                int weight = graph[current][i];
+                if (visited[i] || weight <= 0)
+                    continue;
+                // Keep the cheapest cities found so far, sorted by cost.
+                int at = count < limit ? count++ : limit;
+                while (at > 0 && graph[current][choices[at - 1]] > weight) {
+                    if (at < limit)
+                        choices[at] = choices[at - 1];
+                    --at;
+                }
+                if (at < limit)
+                    choices[at] = i;
+            }
+
+            if (count == 0)
+                return -1;
+
+            int pick = 0;
+            while (random != nullptr && pick + 1 < count &&
+                   (*random)() % SKIP_ODDS == 0)
+                ++pick;
+
+            int next = choices[pick];
+            cost += graph[current][next];
+            visited[next] = true;
+            current = next;
+            tour.push_back(current);
+        }
+
+        if (graph[current][start] <= 0)
+            return -1;
+        return cost + graph[current][start];
+    }
+};
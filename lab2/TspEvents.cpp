@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Steps of the TSP solvers, reported to an event sink. The sink is a
+// template parameter of TSP, so the solvers only fill in a small record and
+// the sink decides what becomes of it.
+enum TspEventType : uint16_t {
+    EVENT_TABLE_ENTRY,   // count: mask, city: last city, other: parent
+    EVENT_PATH_BEGIN,    // reconstruction of the Held-Karp tour starts
+    EVENT_PATH_STEP,     // count: mask, city, other: previous city
+    EVENT_PATH_END,
+    EVENT_NN_BEGIN,      // city: start of the nearest-neighbour tour
+    EVENT_NN_STEP,       // count: step, city: from, other: next city
+    EVENT_NN_STUCK,      // count: step, city: from
+    EVENT_NN_RETURN,     // count: start, city: from, other: edge cost,
+                         // cost: tour cost
+    EVENT_NN_NO_RETURN,  // city: from, other: start
+    EVENT_BB_DONE,       // count: nodes explored by branch and bound
+    EVENT_IMPROVE_DONE,  // count: moves, other: cost before, cost: after
+    EVENT_WINDOW_DONE,   // count: window, other: cost before, cost: after
+};
+
+// One event, 16 bytes; fields that an event type does not use are 0
+struct TspEvent {
+    uint16_t type;
+    uint16_t city;
+    uint32_t count;
+    int32_t other;
+    int32_t cost;
+};
+
+static_assert(sizeof(TspEvent) == 16, "events are written as raw records");
+
+// Sink that drops every event; all calls compile away
+struct NoEvents {
+    static constexpr int TABLE_MAX_CITIES = 0;
+
+    void emit(const TspEvent&) {}
+};
+
+// Sink that prints the events as the text log of the solvers
+struct TextEvents {
+    // The table of larger graphs would be more text than anyone reads
+    static constexpr int TABLE_MAX_CITIES = 10;
+
+    // n: cities, for the width of printed masks
+    TextEvents(int n = 0) : n(n) {}
+
+    void emit(const TspEvent& event) {
+        switch (event.type) {
+        case EVENT_TABLE_ENTRY:
+            cout << "[tsp] mask: " << maskBits(event.count)
+                 << ", pos: " << event.city;
+            if (event.cost == numeric_limits<int>::max())
+                cout << ", no path\n";
+            else
+                cout << ", cost: " << event.cost << ", from: " << event.other
+                     << "\n";
+            break;
+        case EVENT_PATH_BEGIN:
+            cout << "[reconstructPath] Reconstructing path:\n";
+            break;
+        case EVENT_PATH_STEP:
+            cout << "   At mask=" << event.count << ", pos=" << event.city
+                 << " from previous=" << event.other << "\n";
+            break;
+        case EVENT_PATH_END:
+            cout << "[reconstructPath] Leaving start (0)\n";
+            break;
+        case EVENT_NN_BEGIN:
+            cout << "[als] Starting approximation from city " << event.city
+                 << "\n";
+            break;
+        case EVENT_NN_STEP:
+            cout << "   Step " << event.count << ": from city " << event.city
+                 << ", checking neighbors...\n"
+                 << "   Next city " << event.other << " with cost "
+                 << event.cost << "\n";
+            break;
+        case EVENT_NN_STUCK:
+            cout << "   Step " << event.count << ": from city " << event.city
+                 << ", checking neighbors...\n"
+                 << "   No unvisited neighbors found. Approximate solution "
+                    "failed.\n";
+            break;
+        case EVENT_NN_RETURN:
+            cout << "   Returning to start city " << event.count
+                 << " with cost " << event.other << "\n"
+                 << "   Final cost: " << event.cost << "\n";
+            break;
+        case EVENT_NN_NO_RETURN:
+            cout << "   Cannot return to start city. Edge from " << event.city
+                 << " to " << event.other << " is missing.\n";
+            break;
+        case EVENT_BB_DONE:
+            cout << "[branchAndBound] Explored " << event.count << " nodes\n";
+            break;
+        case EVENT_IMPROVE_DONE:
+            cout << "[improve] " << event.count << " moves, cost "
+                 << event.other << " -> " << event.cost << "\n";
+            break;
+        case EVENT_WINDOW_DONE:
+            cout << "[balasSimonetti] window " << event.count << ", cost "
+                 << event.other << " -> " << event.cost << "\n";
+            break;
+        }
+    }
+
+private:
+    int n;
+
+    string maskBits(uint32_t mask) const {
+        string bits(n, '0');
+        for (int i = 0; i < n; ++i)
+            if (mask >> i & 1)
+                bits[n - 1 - i] = '1';
+        return bits;
+    }
+};
+
+// Sink that keeps the last capacity events in memory; write() saves them,
+// oldest first, as raw TspEvent records
+class RingEvents {
+public:
+    // Tables up to 2^15 * 15 entries; a larger one would only overwrite
+    // the rest of the ring many times over
+    static constexpr int TABLE_MAX_CITIES = 16;
+
+    RingEvents(size_t capacity = 1 << 16) : ring(capacity) {}
+
+    void emit(const TspEvent& event) {
+        ring[written % ring.size()] = event;
+        ++written;
+    }
+
+    // Number of events emitted, including the overwritten ones
+    uint64_t count() const { return written; }
+
+    bool write(FILE* file) const {
+        size_t kept = written < ring.size() ? written : ring.size();
+        size_t first = (written - kept) % ring.size();
+        size_t head = min(kept, ring.size() - first);
+        return fwrite(&ring[first], sizeof(TspEvent), head, file) == head &&
+               fwrite(&ring[0], sizeof(TspEvent), kept - head, file) ==
+                   kept - head;
+    }
+
+private:
+    vector<TspEvent> ring;
+    uint64_t written = 0;
+};
@@ -0,0 +1,325 @@
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "BalasSimonetti.cpp"
+#include "BranchAndBound.cpp"
+#include "Generator.cpp"
+#include "HeldKarp.cpp"
+#include "LocalSearch.cpp"
+#include "MultiStart.cpp"
+
+using namespace std;
+
+// Benchmark of the TSP engines: generates the instances of every family,
+// size and seed with the seeded generator of mgen, runs every engine on
+// each of them and prints one record per run as CSV (default) or JSON.
+// Every run is a child process, so its peak memory is its own and a run
+// over the time limit can be stopped. The cost of a tour is compared with
+// the optimum if an exact engine finished, else with the best tour found.
+//
+// Engines:
+//   dp          Held-Karp, with the smallest cost type the instance fits
+//   bb          branch and bound from the multistart tour, skipped if the
+//               costs do not fit into int
+//   multistart  nearest neighbour from every city
+//   local       multistart, then 2-opt / Or-opt local search
+//   window      local, then Balas-Simonetti with --window
+//
+// Command line:
+//   --families LIST  uniform,symmetric,euclidean,clustered,sparse (default)
+//   --sizes LIST     city counts, 5,8,11,14,17,20 by default
+//   --seeds LIST     seeds of each family and size, 1,2,3 by default
+//   --engines LIST   dp,bb,multistart,local,window by default
+//   --min A, --max B weight range, 1..1000 by default
+//   --dp-max N, --bb-max N  largest instance of dp (22) and bb (40)
+//   --limit SEC      time limit of a run, 60 s by default
+//   --window K       window of the window engine, 8 by default
+//   -t N             threads of dp and multistart
+//   --json           print a JSON array instead of CSV
+
+struct BenchOptions {
+    vector<string> families = {"uniform", "symmetric", "euclidean",
+                               "clustered", "sparse"};
+    vector<int> sizes = {5, 8, 11, 14, 17, 20};
+    vector<uint64_t> seeds = {1, 2, 3};
+    vector<string> engines = {"dp", "bb", "multistart", "local", "window"};
+    int min = 1;
+    int max = 1000;
+    int dpMax = 22;
+    int bbMax = 40;
+    int limit = 60;
+    int window = 8;
+    int threadCount = 1;
+    bool json = false;
+};
+
+// What a run sends back to the benchmark
+struct RunResult {
+    long long cost;  // -1 if the engine found no tour
+    double milliseconds;
+    long peakKb;
+};
+
+// One record, before the reference cost is known
+struct Record {
+    string engine;
+    string status;  // ok, timeout, failed or skipped
+    RunResult result;
+};
+
+template <class Cost>
+long long solveHeldKarp(const vector<vector<int>>& graph, int threadCount) {
+    BasicHeldKarp<Cost> heldKarp(graph);
+    Cost cost = heldKarp.solve(threadCount);
+    return cost == BasicHeldKarp<Cost>::INF ? -1 : (long long)cost;
+}
+
+long long solveMultiStart(const vector<vector<int>>& graph,
+                          const BenchOptions& options, vector<int>& tour) {
+    MultiStart multiStart(graph);
+    MultiStart::Result result = multiStart.run(options.threadCount, 0);
+    tour = result.tour;
+    return result.cost;
+}
+
+long long runEngine(const string& engine, const vector<vector<int>>& graph,
+                    const BenchOptions& options) {
+    if (engine == "dp") {
+        if (BasicHeldKarp<uint16_t>::fits(graph))
+            return solveHeldKarp<uint16_t>(graph, options.threadCount);
+        if (BasicHeldKarp<int>::fits(graph))
+            return solveHeldKarp<int>(graph, options.threadCount);
+        return solveHeldKarp<int64_t>(graph, options.threadCount);
+    }
+
+    vector<int> tour;
+    long long cost = solveMultiStart(graph, options, tour);
+
+    // Branch and bound searches on its own if there is no starting tour
+    // or its cost does not fit into int
+    if (engine == "bb") {
+        BranchAndBound branchAndBound(graph);
+        int best = cost == -1 || cost >= BranchAndBound::INF
+                       ? branchAndBound.solve(BranchAndBound::INF, {})
+                       : branchAndBound.solve(int(cost), tour);
+        return best == BranchAndBound::INF ? -1 : best;
+    }
+    if (engine == "multistart" || cost == -1)
+        return cost;
+
+    LocalSearch localSearch(graph);
+    cost = localSearch.improve(tour);
+    if (engine == "local" || cost == -1)
+        return cost;
+
+    BalasSimonetti balasSimonetti(graph);
+    return balasSimonetti.improve(tour, options.window);
+}
+
+// Run an engine in a child process
+Record run(const string& engine, const vector<vector<int>>& graph,
+           const BenchOptions& options) {
+    Record record = {engine, "failed", {-1, 0, 0}};
+    int n = graph.size();
+    if ((engine == "dp" && n > options.dpMax) ||
+        (engine == "bb" &&
+         (n > options.bbMax || !BasicHeldKarp<int>::fits(graph)))) {
+        record.status = "skipped";
+        return record;
+    }
+
+    int channel[2];
+    if (pipe(channel) != 0)
+        return record;
+
+    pid_t child = fork();
+    if (child == 0) {
+        close(channel[0]);
+        alarm(options.limit);
+
+        auto start = chrono::steady_clock::now();
+        RunResult result;
+        result.cost = runEngine(engine, graph, options);
+        result.milliseconds = chrono::duration<double, milli>(
+                                  chrono::steady_clock::now() - start)
+                                  .count();
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        result.peakKb = usage.ru_maxrss;
+
+        ssize_t written = write(channel[1], &result, sizeof(result));
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+    close(channel[1]);
+
+    RunResult result;
+    ssize_t got = child > 0 ? read(channel[0], &result, sizeof(result)) : 0;
+    close(channel[0]);
+    int status = 0;
+    if (child > 0)
+        waitpid(child, &status, 0);
+
+    if (got == sizeof(result)) {
+        record.status = "ok";
+        record.result = result;
+    } else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+        record.status = "timeout";
+        record.result.milliseconds = options.limit * 1000.0;
+    }
+    return record;
+}
+
+void printRecord(const string& family, int n, uint64_t seed,
+                 const Record& record, long long reference,
+                 const string& referenceKind, const BenchOptions& options,
+                 bool& first) {
+    double ratio = record.result.cost > 0 && reference > 0
+                       ? double(record.result.cost) / reference
+                       : 0;
+    if (options.json) {
+        printf(first ? "\n  " : ",\n  ");
+        printf("{\"family\": \"%s\", \"n\": %d, \"seed\": %llu, "
+               "\"engine\": \"%s\", \"status\": \"%s\", \"cost\": %lld, "
+               "\"reference\": %lld, \"reference_kind\": \"%s\", "
+               "\"ratio\": %.6f, \"wall_ms\": %.3f, \"peak_kb\": %ld}",
+               family.c_str(), n, (unsigned long long)seed,
+               record.engine.c_str(), record.status.c_str(),
+               record.result.cost, reference, referenceKind.c_str(), ratio,
+               record.result.milliseconds, record.result.peakKb);
+    } else {
+        printf("%s,%d,%llu,%s,%s,%lld,%lld,%s,%.6f,%.3f,%ld\n",
+               family.c_str(), n, (unsigned long long)seed,
+               record.engine.c_str(), record.status.c_str(),
+               record.result.cost, reference, referenceKind.c_str(), ratio,
+               record.result.milliseconds, record.result.peakKb);
+    }
+    first = false;
+    fflush(stdout);
+}
+
+template <class Value, class Parse>
+vector<Value> parseList(const string& text, Parse parse) {
+    vector<Value> values;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ','))
+        if (!item.empty())
+            values.push_back(parse(item));
+    return values;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    auto asString = [](const string& item) { return item; };
+    auto asInt = [](const string& item) { return stoi(item); };
+    auto asSeed = [](const string& item) { return uint64_t(stoull(item)); };
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--families" && i + 1 < argc)
+            options.families = parseList<string>(argv[++i], asString);
+        else if (option == "--sizes" && i + 1 < argc)
+            options.sizes = parseList<int>(argv[++i], asInt);
+        else if (option == "--seeds" && i + 1 < argc)
+            options.seeds = parseList<uint64_t>(argv[++i], asSeed);
+        else if (option == "--engines" && i + 1 < argc)
+            options.engines = parseList<string>(argv[++i], asString);
+        else if (option == "--min" && i + 1 < argc)
+            options.min = stoi(argv[++i]);
+        else if (option == "--max" && i + 1 < argc)
+            options.max = stoi(argv[++i]);
+        else if (option == "--dp-max" && i + 1 < argc)
+            options.dpMax = stoi(argv[++i]);
+        else if (option == "--bb-max" && i + 1 < argc)
+            options.bbMax = stoi(argv[++i]);
+        else if (option == "--limit" && i + 1 < argc)
+            options.limit = stoi(argv[++i]);
+        else if (option == "--window" && i + 1 < argc)
+            options.window = stoi(argv[++i]);
+        else if (option == "-t" && i + 1 < argc)
+            options.threadCount = stoi(argv[++i]);
+        else if (option == "--json")
+            options.json = true;
+    }
+
+    Generator::Mode mode;
+    for (const string& family : options.families) {
+        if (!Generator::findMode(family, mode)) {
+            cerr << "Unknown family " << family << endl;
+            return 1;
+        }
+    }
+    for (const string& engine : options.engines) {
+        if (engine != "dp" && engine != "bb" && engine != "multistart" &&
+            engine != "local" && engine != "window") {
+            cerr << "Unknown engine " << engine << endl;
+            return 1;
+        }
+    }
+    if (options.threadCount == 0)
+        options.threadCount = thread::hardware_concurrency();
+    options.dpMax = min(options.dpMax, HeldKarp::MAX_CITIES);
+
+    if (options.json)
+        printf("[");
+    else
+        printf("family,n,seed,engine,status,cost,reference,reference_kind,"
+               "ratio,wall_ms,peak_kb\n");
+    fflush(stdout);
+
+    bool first = true;
+    for (const string& family : options.families) {
+        for (int n : options.sizes) {
+            for (uint64_t seed : options.seeds) {
+                Generator::Settings settings;
+                Generator::findMode(family, settings.mode);
+                settings.n = n;
+                settings.min = options.min;
+                settings.max = options.max;
+                settings.seed = seed;
+                Generator generator(settings);
+                vector<vector<int>> graph(n, vector<int>(n));
+                for (int i = 0; i < n; ++i)
+                    generator.row(i, graph[i].data());
+
+                vector<Record> records;
+                for (const string& engine : options.engines)
+                    records.push_back(run(engine, graph, options));
+
+                // The optimum if an exact engine finished, else the best
+                // tour of all
+                long long reference = -1;
+                string referenceKind = "none";
+                for (const Record& record : records) {
+                    bool exact = record.engine == "dp" || record.engine == "bb";
+                    if (record.status != "ok" || record.result.cost == -1)
+                        continue;
+                    if (exact && referenceKind != "optimum") {
+                        reference = record.result.cost;
+                        referenceKind = "optimum";
+                    } else if (referenceKind != "optimum" &&
+                               (reference == -1 ||
+                                record.result.cost < reference)) {
+                        reference = record.result.cost;
+                        referenceKind = "best";
+                    }
+                }
+
+                for (const Record& record : records)
+                    printRecord(family, n, seed, record, reference,
+                                referenceKind, options, first);
+            }
+        }
+    }
+
+    if (options.json)
+        printf("\n]\n");
+
+    return 0;
+}
@@ -1,131 +1,217 @@
 #include <algorithm>
-#include <bitset>
+#include <cstdio>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
 #include <vector>
+#include "BalasSimonetti.cpp"
+#include "BranchAndBound.cpp"
+#include "HeldKarp.cpp"
+#include "LocalSearch.cpp"
+#include "Matrix.cpp"
+#include "MultiStart.cpp"
+#include "TspEvents.cpp"
 
 using namespace std;
 
 const int INF = numeric_limits<int>::max();
 
-class TSP {
+// Largest graph the auto exact method gives to branch and bound when the
+// Held-Karp table does not fit; above it the exact stage is skipped
+const int AUTO_BB_MAX_CITIES = 40;
+
+// The solvers report their steps to the Events sink (see TspEvents.cpp):
+// TextEvents prints them, NoEvents drops them at compile time and
+// RingEvents keeps the last ones as binary records.
+// Cost and Parent are the entry types of the Held-Karp table (see
+// BasicHeldKarp); the graph must fit into Cost.
+template <class Events = TextEvents, class Cost = int, class Parent = uint8_t>
+class BasicTSP {
 private:
+    typedef BasicHeldKarp<Cost, Parent> Table;
+
     int n;
     const vector<vector<int>>& graph;
-    vector<vector<int>> dp;
-    vector<vector<int>> parent;
-    vector<string> tspLog;
+    unique_ptr<Table> heldKarp;  // built by solveExact only
+    int threadCount;
+    BasicMinPlusKernel<Cost> kernel;
+    Events events;
 
 public:
-    TSP(int n, const vector<vector<int>>& graph) : n(n), graph(graph) {}
+    BasicTSP(int n, const vector<vector<int>>& graph, int threadCount = 1,
+             Events events = Events())
+        : n(n), graph(graph), threadCount(threadCount),
+          kernel(findMinPlusFor<Cost>("auto")), events(events) {}
+
+    void setKernel(BasicMinPlusKernel<Cost> kernel) {
+        this->kernel = kernel;
+    }
 
-    pair<int, vector<int>> solveExact() {
-        dp.assign(1 << n, vector<int>(n, -1));
-        parent.assign(1 << n, vector<int>(n, -1));
+    Events& sink() { return events; }
 
-        int minCost = tsp(1, 0);
-        if (minCost >= INF) {
+    pair<long long, vector<int>> solveExact() {
+        heldKarp.reset(new Table(graph));
+        heldKarp->setKernel(kernel);
+        Cost minCost = heldKarp->solve(threadCount);
+        if (minCost == Table::INF) {
             return make_pair(-1, vector<int>{});
         }
 
-        reverse(tspLog.begin(), tspLog.end());
-        for (string& log : tspLog) {
-            cout << log << endl;
-        }
-        tspLog.clear();
+        if (n <= Events::TABLE_MAX_CITIES)
+            emitTable();
 
         return make_pair(minCost, reconstructPath());
     }
 
-    pair<int, vector<int>> solveApproximate(int start) { return als(start); }
+    // Exact solution in memory polynomial in n, starting from the tour of
+    // the approximate solution, within maxNodes nodes and the time limit.
+    // complete is false if the budget ran out before the tour was proven
+    // optimal.
+    pair<long long, vector<int>> solveBranchAndBound(long long maxNodes,
+                                                     double milliseconds,
+                                                     bool& complete) {
+        pair<long long, vector<int>> initial = als(0);
 
-private:
-    int tsp(int mask, int pos) {
-        if (mask == (1 << n) - 1) {
-            tspLog.push_back("[tsp] Trying to return to start from " +
-                             to_string(pos));
-            if (graph[pos][0] == 0) {
-                tspLog.push_back(
-                    "[tsp] No path to start, cycle not found, returning "
-                    "INF");
-                return INF;
-            } else {
-                tspLog.push_back(
-                    "[tsp] Cycle found, returning to start with cost " +
-                    to_string(graph[pos][0]));
-                return graph[pos][0];
-            }
+        // Branch and bound works on int costs
+        if (initial.first >= INF)
+            initial = make_pair(-1, vector<int>{});
+
+        BranchAndBound branchAndBound(graph);
+        branchAndBound.setBudget(maxNodes, milliseconds);
+        int minCost = branchAndBound.solve(
+            initial.first == -1 ? INF : int(initial.first), initial.second);
+
+        emit(EVENT_BB_DONE, 0, branchAndBound.nodeCount());
+        complete = branchAndBound.complete();
+        if (minCost >= INF) {
+            return make_pair(-1, vector<int>{});
         }
+        return make_pair(minCost, branchAndBound.tour());
+    }
+
+    pair<long long, vector<int>> solveApproximate(int start) {
+        return als(start);
+    }
+
+    // Best nearest-neighbour tour over all start cities and randomizedRuns
+    // randomized constructions
+    pair<long long, vector<int>> solveMultiStart(int randomizedRuns) {
+        MultiStart multiStart(graph);
+        MultiStart::Result result =
+            multiStart.run(threadCount, randomizedRuns);
+
+        printCosts("[multiStart] Start cities", result.startCosts);
+        if (randomizedRuns > 0)
+            printCosts("[multiStart] Randomized runs", result.randomCosts);
 
-        if (dp[mask][pos] != -1) {
-            tspLog.push_back("[tsp] Using memoized for mask: " +
-                             bitset<32>(mask).to_string().substr(32 - n) +
-                             ", pos: " + to_string(pos) +
-                             ", value: " + to_string(dp[mask][pos]));
-            return dp[mask][pos];
+        return make_pair(result.cost, result.tour);
+    }
+
+    // Shorten a tour with 2-opt and Or-opt moves, within maxMoves moves
+    // and the time limit
+    pair<long long, vector<int>>
+    improve(const pair<long long, vector<int>>& result, long long maxMoves,
+            double milliseconds) {
+        if (result.first == -1) {
+            return result;
         }
 
-        int ans = INF;
-        for (int city = 0; city < n; ++city) {
-            if (!(mask & (1 << city)) && graph[pos][city] > 0) {
-                int newMask = mask | (1 << city);
-                int nextCost = tsp(newMask, city);
-                if (nextCost != INF) {
-                    int newCost = graph[pos][city] + nextCost;
-                    tspLog.push_back("  From " + to_string(pos) + " to " +
-                                     to_string(city) +
-                                     " | cost: " + to_string(graph[pos][city]) +
-                                     ", total cost: " + to_string(newCost));
-                    if (newCost < ans) {
-                        ans = newCost;
-                        parent[mask][pos] = city;
-                        tspLog.push_back(
-                            "[tsp] Updating best next city from " +
-                            to_string(pos) + " with mask " +
-                            bitset<32>(mask).to_string().substr(32 - n) +
-                            " to " + to_string(city) +
-                            " (new cost: " + to_string(ans) + ")");
-                    }
-                } else {
-                    tspLog.push_back("No path from " + to_string(pos) + " to " +
-                                     to_string(city) + ", skipping...");
-                }
-            }
+        LocalSearch localSearch(graph);
+        localSearch.setBudget(maxMoves, milliseconds);
+
+        vector<int> tour = result.second;
+        long long cost = localSearch.improve(tour);
+        emit(EVENT_IMPROVE_DONE, 0, localSearch.moveCount(), result.first,
+             cost);
+        return make_pair(cost, tour);
+    }
+
+    // Reorder a tour within windows of window positions by the
+    // Balas-Simonetti dynamic programming
+    pair<long long, vector<int>>
+    improveWindow(const pair<long long, vector<int>>& result, int window) {
+        if (result.first == -1) {
+            return result;
         }
 
-        dp[mask][pos] = ans;
-        return ans;
+        BasicBalasSimonetti<Cost> balasSimonetti(graph);
+        balasSimonetti.setKernel(kernel);
+
+        vector<int> tour = result.second;
+        long long cost = balasSimonetti.improve(tour, window);
+        emit(EVENT_WINDOW_DONE, 0, window, result.first, cost);
+        return make_pair(cost, tour);
+    }
+
+private:
+    // Costs above INT_MAX are reported as INT_MAX
+    void emit(TspEventType type, int city, long long count = 0,
+              long long other = 0, long long cost = 0) {
+        events.emit(TspEvent{type, uint16_t(city),
+                             uint32_t(min<long long>(count, UINT32_MAX)),
+                             int32_t(min<long long>(other, INF)),
+                             int32_t(min<long long>(cost, INF))});
+    }
+
+    // Distribution of tour costs, -1 for runs without a tour
+    void printCosts(const string& title, vector<long long> costs) {
+        int failed = count(costs.begin(), costs.end(), -1);
+        costs.erase(remove(costs.begin(), costs.end(), -1), costs.end());
+        sort(costs.begin(), costs.end());
+
+        cout << title << ": " << costs.size() + failed << " runs, " << failed
+             << " without a tour" << endl;
+        if (costs.empty())
+            return;
+
+        long long sum = 0;
+        for (long long cost : costs)
+            sum += cost;
+        cout << "   min " << costs.front() << ", median "
+             << costs[costs.size() / 2] << ", mean "
+             << sum / (long long)costs.size()
+             << ", max " << costs.back() << endl;
+    }
+
+    void emitTable() {
+        for (uint32_t mask = 1; mask < (1u << n); mask += 2) {
+            for (int pos = 1; pos < n; ++pos) {
+                if (!(mask & (1u << pos)))
+                    continue;
+                Cost cost = heldKarp->cost(mask, pos);
+                emit(EVENT_TABLE_ENTRY, pos, mask, heldKarp->parent(mask, pos),
+                     cost == Table::INF ? INF : (long long)cost);
+            }
+        }
     }
 
     vector<int> reconstructPath() {
         vector<int> path = {0};
-        int mask = 1, pos = 0;
-
-        cout << "[reconstructPath] Reconstructing path:" << endl;
-        while (mask != (1 << n) - 1) {
-            int next = parent[mask][pos];
-            if (next == -1) {
-                cout << "   Incomplete path: parent[" << mask << "][" << pos
-                     << "] = -1" << endl;
-                return {};
-            }
-            cout << "   At mask=" << mask << ", pos=" << pos
-                 << " to next=" << next << endl;
-            path.push_back(next);
-            mask |= (1 << next);
-            pos = next;
+        int mask = (1 << n) - 1, pos = heldKarp->lastCity();
+
+        emit(EVENT_PATH_BEGIN, 0);
+        while (pos != 0) {
+            int previous = heldKarp->parent(mask, pos);
+            emit(EVENT_PATH_STEP, pos, mask, previous);
+            path.push_back(pos);
+            mask ^= (1 << pos);
+            pos = previous;
         }
 
-        cout << "[reconstructPath] Returning to start (0)" << endl;
+        emit(EVENT_PATH_END, 0);
         path.push_back(0);
+        reverse(path.begin(), path.end());
         return path;
     }
 
-    pair<int, vector<int>> als(int start) {
-        cout << "[als] Starting approximation from city " << start << endl;
+    pair<long long, vector<int>> als(int start) {
+        emit(EVENT_NN_BEGIN, start);
         vector<bool> visited(n, false);
         vector<int> path;
-        int cost = 0;
+        long long cost = 0;
         int current = start;
         visited[current] = true;
         path.push_back(current);
@@ -134,9 +220,6 @@ private:
             int nextCity = -1;
             int minDist = INF;
 
-            cout << "   Step " << step << ": from city " << current
-                 << ", checking neighbors..." << endl;
-
             for (int i = 0; i < n; ++i) {
                 if (!visited[i] && graph[current][i] > 0 &&
                     graph[current][i] < minDist) {
@@ -146,13 +229,10 @@ private:
             }
 
             if (nextCity == -1) {
-                cout << "   No unvisited neighbors found. Approximate solution "
-                        "failed."
-                     << endl;
+                emit(EVENT_NN_STUCK, current, step);
                 return make_pair(-1, vector<int>{});
             }
-            cout << "   Next city " << nextCity << " with cost " << minDist
-                 << endl;
+            emit(EVENT_NN_STEP, current, step, nextCity, minDist);
             cost += minDist;
             visited[nextCity] = true;
             current = nextCity;
@@ -162,50 +242,311 @@ private:
         if (graph[current][start] > 0) {
             cost += graph[current][start];
             path.push_back(start);
-            cout << "   Returning to start city " << start << " with cost "
-                 << graph[current][start] << endl;
-            cout << "   Final cost: " << cost << endl;
+            emit(EVENT_NN_RETURN, current, start, graph[current][start], cost);
             return make_pair(cost, path);
         } else {
-            cout << "   Cannot return to start city. Edge from " << current
-                 << " to " << start << " is missing." << endl;
+            emit(EVENT_NN_NO_RETURN, current, 0, start);
             return make_pair(-1, vector<int>{});
         }
     }
 };
 
-int main() {
-    int n;
-    cin >> n;
-
-    vector<vector<int>> graph(n, vector<int>(n));
-    for (int i = 0; i < n; ++i)
-        for (int j = 0; j < n; ++j)
-            cin >> graph[i][j];
+using TSP = BasicTSP<>;
 
-    TSP tsp(n, graph);
+struct Options {
+    int threadCount = 1;
+    string kernel = "auto";
+    string method = "auto";
+    string cost = "auto";
+    string parents = "auto";
+    string input;
+    long long bbNodes = numeric_limits<long long>::max();
+    double bbTime = 10000;
+    long long maxMoves = numeric_limits<long long>::max();
+    double improveTime = 1000;
+    int window = 0;
+    bool multiStart = false;
+    int randomizedRuns = 0;
+    size_t memoryLimit = 0;
+    string trace = "text";
+    string traceFile = "tsp.trace";
+    size_t ringSize = 1 << 16;
+};
 
-    cout << "Exact solution:" << endl;
-    pair<int, vector<int>> exactResult = tsp.solveExact();
-    if (exactResult.first == -1) {
+void printResult(const pair<long long, vector<int>>& result) {
+    if (result.first == -1) {
         cout << "no path" << endl;
     } else {
-        cout << exactResult.first << endl;
-        for (int city : exactResult.second)
+        cout << result.first << endl;
+        for (int city : result.second)
             cout << city << " ";
         cout << endl;
     }
+}
+
+// Write the events a sink kept to the trace file, false if that fails
+bool saveTrace(const TextEvents&, const Options&) { return true; }
+
+bool saveTrace(const NoEvents&, const Options&) { return true; }
+
+bool saveTrace(const RingEvents& events, const Options& options) {
+    FILE* file = fopen(options.traceFile.c_str(), "wb");
+    if (file == nullptr) {
+        cout << "Cannot write " << options.traceFile << endl;
+        return false;
+    }
+    bool written = events.write(file);
+    if (fclose(file) != 0 || !written) {
+        cout << "Cannot write " << options.traceFile << endl;
+        return false;
+    }
+    return true;
+}
+
+// Solve with the Held-Karp table of Cost and Parent entries, false if the
+// kernel or the trace file fails
+template <class Events, class Cost, class Parent>
+bool solve(int n, const vector<vector<int>>& graph, const Options& options,
+           const string& method, Events events) {
+    BasicTSP<Events, Cost, Parent> tsp(n, graph, options.threadCount, events);
+    BasicMinPlusKernel<Cost> kernel = findMinPlusFor<Cost>(options.kernel);
+    if (kernel == nullptr) {
+        cout << "Unknown or unsupported kernel" << endl;
+        return false;
+    }
+    tsp.setKernel(kernel);
+
+    if (method == "dp") {
+        cout << "Exact solution:" << endl;
+        printResult(tsp.solveExact());
+    } else if (method == "bb") {
+        cout << "Exact solution:" << endl;
+        bool complete = true;
+        printResult(tsp.solveBranchAndBound(options.bbNodes, options.bbTime,
+                                            complete));
+        if (!complete)
+            cout << "Branch and bound budget exhausted, the tour is not "
+                    "proven optimal"
+                 << endl;
+    }
 
     cout << "Approximate solution:" << endl;
-    pair<int, vector<int>> approximateResult = tsp.solveApproximate(0);
-    if (approximateResult.first == -1) {
-        cout << "no path" << endl;
-    } else {
-        cout << approximateResult.first << endl;
-        for (int city : approximateResult.second)
-            cout << city << " ";
-        cout << endl;
+    pair<long long, vector<int>> approximateResult = tsp.solveApproximate(0);
+    printResult(approximateResult);
+
+    if (options.multiStart) {
+        cout << "Multi-start solution:" << endl;
+        pair<long long, vector<int>> multiStartResult =
+            tsp.solveMultiStart(options.randomizedRuns);
+        printResult(multiStartResult);
+        if (approximateResult.first == -1 ||
+            (multiStartResult.first != -1 &&
+             multiStartResult.first < approximateResult.first))
+            approximateResult = multiStartResult;
+    }
+
+    cout << "Improved solution:" << endl;
+    pair<long long, vector<int>> improvedResult =
+        tsp.improve(approximateResult, options.maxMoves, options.improveTime);
+    printResult(improvedResult);
+
+    if (options.window > 0) {
+        cout << "Window solution:" << endl;
+        printResult(tsp.improveWindow(improvedResult, options.window));
+    }
+    return saveTrace(tsp.sink(), options);
+}
+
+// Keep the parent table if it fits into the memory limit (or on --parents
+// store), and choose the exact method
+template <class Events, class Cost>
+bool solve(int n, const vector<vector<int>>& graph, const Options& options,
+           Events events) {
+    typedef BasicHeldKarp<Cost, uint8_t> WithParents;
+    typedef BasicHeldKarp<Cost, void> WithoutParents;
+
+    bool storeParents = options.parents == "store" ||
+                        (options.parents == "auto" &&
+                         WithParents::memoryFor(n) <= options.memoryLimit);
+
+    string method = options.method;
+    if (method == "auto") {
+        size_t memory = storeParents ? WithParents::memoryFor(n)
+                                     : WithoutParents::memoryFor(n);
+        bool fits =
+            n <= HeldKarp::MAX_CITIES && memory <= options.memoryLimit;
+        if (fits)
+            method = "dp";
+        else if (n <= AUTO_BB_MAX_CITIES && BasicHeldKarp<int>::fits(graph))
+            method = "bb";
+        else
+            method = "none";
+    }
+
+    if (storeParents)
+        return solve<Events, Cost, uint8_t>(n, graph, options, method, events);
+    return solve<Events, Cost, void>(n, graph, options, method, events);
+}
+
+// Solve with the cost type of --cost, or the smallest one the graph fits
+// into (and that has the kernel)
+template <class Events>
+bool solve(int n, const vector<vector<int>>& graph, const Options& options,
+           Events events) {
+    string cost = options.cost;
+    if (cost == "auto") {
+        if (BasicHeldKarp<uint16_t>::fits(graph) &&
+            findMinPlusFor<uint16_t>(options.kernel) != nullptr)
+            cost = "uint16";
+        else if (BasicHeldKarp<int>::fits(graph))
+            cost = "int";
+        else
+            cost = "int64";
+    }
+
+    bool fits = cost == "uint16"   ? BasicHeldKarp<uint16_t>::fits(graph)
+                : cost == "int"    ? BasicHeldKarp<int>::fits(graph)
+                : cost == "uint32" ? BasicHeldKarp<uint32_t>::fits(graph)
+                                   : BasicHeldKarp<int64_t>::fits(graph);
+    if (!fits) {
+        cout << "Path costs do not fit into " << cost << endl;
+        return false;
+    }
+
+    if (cost == "uint16")
+        return solve<Events, uint16_t>(n, graph, options, events);
+    if (cost == "int")
+        return solve<Events, int>(n, graph, options, events);
+    if (cost == "uint32")
+        return solve<Events, uint32_t>(n, graph, options, events);
+    return solve<Events, int64_t>(n, graph, options, events);
+}
+
+int main(int argc, char* argv[]) {
+    // Command line:
+    //   -i FILE  matrix file, text or binary (see Matrix.cpp); stdin by
+    //            default
+    //   -t N  threads of the exact solution, 0 means one per hardware thread
+    //   -k NAME  min-plus kernel of the exact solution: auto (default),
+    //            scalar, avx2 or avx512
+    //   -e NAME  exact method: dp (Held-Karp, up to 31 cities), bb (branch
+    //            and bound, path costs must fit into int), none or auto
+    //            (default): dp if its table fits into the memory limit,
+    //            else bb up to 40 cities, else none
+    //   --bb-nodes N  nodes of branch and bound, unlimited by default
+    //   --bb-time MS  time limit of branch and bound, 10000 ms by default
+    //   -m MB    memory limit of dp, half of the free memory by default
+    //   --moves N   improving moves of the local search, unlimited by default
+    //   --time MS   time limit of the local search, 1000 ms by default
+    //   --window K  also reorder the improved tour within windows of K
+    //               positions (Balas-Simonetti, K <= 15), off by default
+    //   --multi-start    also build nearest-neighbour tours from every city
+    //                    on -t threads, the local search starts from the best
+    //   --randomized N   randomized runs of the multi-start, 0 by default
+    //   --trace NAME     log of the solvers: text (default) prints it, none
+    //                    drops it, ring keeps its last events in memory and
+    //                    writes them to the trace file as 16-byte records
+    //   --trace-file FILE   trace file of --trace ring, tsp.trace by default
+    //   --ring N    events kept by --trace ring, 65536 by default
+    //   --cost NAME  entries of the dp table: uint16, int, uint32, int64 or
+    //                auto (default): the smallest one all path costs fit in
+    //   --parents NAME  store keeps the parent of every dp entry, recompute
+    //                   finds the parents of the tour again from the costs,
+    //                   auto (default) stores them if they fit into -m
+    Options options;
+    options.memoryLimit = size_t(sysconf(_SC_AVPHYS_PAGES)) *
+                          size_t(sysconf(_SC_PAGE_SIZE)) / 2;
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if ((option == "-i" || option == "--input") && i + 1 < argc)
+            options.input = argv[++i];
+        else if ((option == "-t" || option == "--threads") && i + 1 < argc)
+            options.threadCount = stoi(argv[++i]);
+        else if ((option == "-k" || option == "--kernel") && i + 1 < argc)
+            options.kernel = argv[++i];
+        else if ((option == "-e" || option == "--exact") && i + 1 < argc)
+            options.method = argv[++i];
+        else if ((option == "-m" || option == "--memory") && i + 1 < argc)
+            options.memoryLimit = stoull(argv[++i]) << 20;
+        else if (option == "--bb-nodes" && i + 1 < argc)
+            options.bbNodes = stoll(argv[++i]);
+        else if (option == "--bb-time" && i + 1 < argc)
+            options.bbTime = stod(argv[++i]);
+        else if (option == "--moves" && i + 1 < argc)
+            options.maxMoves = stoll(argv[++i]);
+        else if (option == "--time" && i + 1 < argc)
+            options.improveTime = stod(argv[++i]);
+        else if (option == "--window" && i + 1 < argc)
+            options.window = stoi(argv[++i]);
+        else if (option == "--multi-start")
+            options.multiStart = true;
+        else if (option == "--randomized" && i + 1 < argc)
+            options.randomizedRuns = stoi(argv[++i]);
+        else if (option == "--trace" && i + 1 < argc)
+            options.trace = argv[++i];
+        else if (option == "--trace-file" && i + 1 < argc)
+            options.traceFile = argv[++i];
+        else if (option == "--ring" && i + 1 < argc)
+            options.ringSize = stoull(argv[++i]);
+        else if (option == "--cost" && i + 1 < argc)
+            options.cost = argv[++i];
+        else if (option == "--parents" && i + 1 < argc)
+            options.parents = argv[++i];
+    }
+    if (options.method != "auto" && options.method != "dp" &&
+        options.method != "bb" && options.method != "none") {
+        cout << "Unknown exact method" << endl;
+        return 1;
+    }
+    if (options.trace != "text" && options.trace != "none" &&
+        options.trace != "ring") {
+        cout << "Unknown trace" << endl;
+        return 1;
+    }
+    if (options.cost != "auto" && options.cost != "uint16" &&
+        options.cost != "int" && options.cost != "uint32" &&
+        options.cost != "int64") {
+        cout << "Unknown cost type" << endl;
+        return 1;
+    }
+    if (options.parents != "auto" && options.parents != "store" &&
+        options.parents != "recompute") {
+        cout << "Unknown parents" << endl;
+        return 1;
+    }
+    if (options.ringSize == 0)
+        options.ringSize = 1;
+    if (options.threadCount == 0)
+        options.threadCount = thread::hardware_concurrency();
+
+    vector<vector<int>> graph;
+    if (!readMatrix(options.input, graph)) {
+        cout << "Cannot read the matrix" << endl;
+        return 1;
+    }
+    int n = graph.size();
+    if (n < 1) {
+        cout << "The matrix has no cities" << endl;
+        return 1;
+    }
+    if (options.method == "dp" && n > HeldKarp::MAX_CITIES) {
+        cout << "Held-Karp takes at most " << HeldKarp::MAX_CITIES
+             << " cities" << endl;
+        return 1;
+    }
+    if (options.method == "bb" && !BasicHeldKarp<int>::fits(graph)) {
+        cout << "Path costs do not fit into int, which branch and bound "
+                "needs"
+             << endl;
+        return 1;
     }
 
-    return 0;
+    bool solved;
+    if (options.trace == "text")
+        solved = solve(n, graph, options, TextEvents(n));
+    else if (options.trace == "none")
+        solved = solve(n, graph, options, NoEvents());
+    else
+        solved = solve(n, graph, options, RingEvents(options.ringSize));
+    return solved ? 0 : 1;
 }
@@ -1,32 +1,117 @@
+#include <algorithm>
 #include <iostream>
 #include <random>
+#include <string>
+#include <thread>
 #include <vector>
+#include "Generator.cpp"
+#include "Matrix.cpp"
 
 using namespace std;
 
-int main() {
-    int size = 5, min = 0, max = 100;
-    cin >> size >> min >> max;
+int main(int argc, char* argv[]) {
+    // Command line:
+    //   -n N, --min A, --max B  size and weight range; without -n they are
+    //                           read from stdin as "N A B"
+    //   --mode NAME   uniform (default), symmetric, euclidean, clustered or
+    //                 sparse (see Generator.cpp)
+    //   --seed S      seed of the matrix, a random one by default
+    //   --missing P   sparse: probability of a missing edge, 0.3 by default
+    //   --clusters K  clustered: number of clusters, n / 100 by default
+    //   -t N          threads generating rows, 0 means one per hardware
+    //                 thread; the matrix does not depend on it
+    //   -b, --binary  write the binary matrix format (see Matrix.cpp) with
+    //                 the smallest element type that holds the weights
+    //   -o FILE       write to FILE instead of stdout
+    Generator::Settings settings;
+    bool sizeGiven = false;
+    bool seedGiven = false;
+    int threadCount = 1;
+    bool binary = false;
+    string output;
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "-n" && i + 1 < argc) {
+            settings.n = stoi(argv[++i]);
+            sizeGiven = true;
+        } else if (option == "--min" && i + 1 < argc) {
+            settings.min = stoi(argv[++i]);
+        } else if (option == "--max" && i + 1 < argc) {
+            settings.max = stoi(argv[++i]);
+        } else if (option == "--mode" && i + 1 < argc) {
+            if (!Generator::findMode(argv[++i], settings.mode)) {
+                cerr << "Unknown mode" << endl;
+                return 1;
+            }
+        } else if (option == "--seed" && i + 1 < argc) {
+            settings.seed = stoull(argv[++i]);
+            seedGiven = true;
+        } else if (option == "--missing" && i + 1 < argc) {
+            settings.missing = stod(argv[++i]);
+        } else if (option == "--clusters" && i + 1 < argc) {
+            settings.clusters = stoi(argv[++i]);
+        } else if (option == "-t" && i + 1 < argc) {
+            threadCount = stoi(argv[++i]);
+        } else if (option == "-b" || option == "--binary") {
+            binary = true;
+        } else if (option == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        }
+    }
+    if (!sizeGiven)
+        cin >> settings.n >> settings.min >> settings.max;
+    if (settings.n < 0 || settings.min > settings.max) {
+        cerr << "Invalid size or weight range" << endl;
+        return 1;
+    }
+    if (!seedGiven) {
+        random_device rd;
+        settings.seed = (uint64_t(rd()) << 32) | rd();
+    }
+    if (threadCount <= 0)
+        threadCount = max(1u, thread::hardware_concurrency());
+
+    FILE* file = output.empty() ? stdout : fopen(output.c_str(), "wb");
+    if (file == nullptr) {
+        cerr << "Cannot write " << output << endl;
+        return 1;
+    }
 
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<int> dist(min, max);
+    Generator generator(settings);
+    MatrixElement element =
+        settings.min < 0 ? ELEMENT_INT32 : elementFor(generator.largest());
+    MatrixWriter writer(file, settings.n, binary, element,
+                        generator.symmetric());
 
-    vector<vector<int>> matrix(size, vector<int>(size, 0));
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            if (i == j)
-                continue;
-            matrix[i][j] = dist(gen);
-        }
+    // Rows are generated in batches of about 4M entries on all threads and
+    // written out before the next batch, so memory stays O(n)
+    int n = settings.n;
+    int batchRows = int(max<long long>(threadCount, (4 << 20) / max(n, 1)));
+    vector<int> batch(size_t(min(batchRows, max(n, 1))) * n);
+    for (int first = 0; first < n; first += batchRows) {
+        int rows = min(batchRows, n - first);
+        auto work = [&](int worker) {
+            for (int k = worker; k < rows; k += threadCount)
+                generator.row(first + k, &batch[size_t(k) * n]);
+        };
+
+        vector<thread> workers;
+        for (int i = 1; i < min(threadCount, rows); ++i)
+            workers.emplace_back(work, i);
+        work(0);
+        for (auto& worker : workers)
+            worker.join();
+
+        for (int k = 0; k < rows; ++k)
+            writer.writeRow(first + k, &batch[size_t(k) * n]);
     }
 
-    cout << size << endl;
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            cout << matrix[i][j] << " ";
-        }
-        cout << endl;
+    bool written = writer.flush();
+    if (file != stdout && fclose(file) != 0)
+        written = false;
+    if (!written) {
+        cerr << "Cannot write the matrix" << endl;
+        return 1;
     }
     return 0;
 }
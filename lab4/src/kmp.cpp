@@ -1,22 +1,38 @@
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
 
+// The vector scans exist only on x86; elsewhere the scalar scan is the only one
+#if defined(__x86_64__) || defined(__i386__)
+#define KMP_X86 1
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
 // Computes the prefix function (partial match table) for the KMP algorithm
-// Input: String Line (pattern to preprocess)
+// Input: String Line (pattern to preprocess), viewed without a copy
 // Output: Vector of prefix lengths for each position in the pattern
-vector<int> CalculatingPrefixFunction(string Line)
+vector<size_t> CalculatingPrefixFunction(string_view Line)
 {
-    int LineLength = Line.length();
-    vector<int> prefixes(LineLength);  // Initialize prefix table
+    size_t LineLength = Line.length();
+    vector<size_t> prefixes(LineLength);  // Initialize prefix table
+    if (LineLength == 0)
+        return prefixes;
     prefixes[0] = 0;  // Base case: first character has prefix length 0
 
     // Build prefix table for each position in the string
-    for (int i = 1; i < LineLength; i++)
+    for (size_t i = 1; i < LineLength; i++)
     {
         // Start with prefix length of previous character
-        int ActualLineLength = prefixes[i - 1];
+        size_t ActualLineLength = prefixes[i - 1];
         
         // While we have a partial match and current characters don't match,
         // backtrack using the prefix table
@@ -33,38 +49,390 @@ vector<int> CalculatingPrefixFunction(string Line)
     return prefixes;
 }
 
+// State of a KMP search that continues over consecutive chunks of text
+struct KmpState
+{
+    size_t FirstLineStep = 0;  // Current position in pattern
+    uint64_t Offset = 0;       // Position of the next text character in the whole text
+};
+
+// Candidate scan of the KMP search: the first position j in [From, Length) where
+// Text[j] == First and, if Pair is set, Text[j + 1] == Second (or j is the last
+// position of the text, whose next byte is not known yet). Returns Length if
+// there is none. The search runs it only between partial matches, where bytes
+// that cannot start the pattern leave the state at 0, so every byte is still
+// looked at a constant number of times and KMP stays linear.
+typedef size_t (*CandidateScan)(const char* Text, size_t From, size_t Length, char First,
+                                char Second, bool Pair);
+
+size_t CandidateScanScalar(const char* Text, size_t From, size_t Length, char First,
+                           char Second, bool Pair)
+{
+    for (size_t j = From; j < Length; j++)
+    {
+        if (Text[j] == First && (!Pair || j + 1 == Length || Text[j + 1] == Second))
+            return j;
+    }
+    return Length;
+}
+
+#ifdef KMP_X86
+// 16 positions per step: compares Text[j..j+15] with First and Text[j+1..j+16] with Second
+__attribute__((target("sse2"))) size_t CandidateScanSse2(const char* Text, size_t From,
+                                                         size_t Length, char First, char Second,
+                                                         bool Pair)
+{
+    const __m128i Firsts = _mm_set1_epi8(First);
+    const __m128i Seconds = _mm_set1_epi8(Second);
+    size_t j = From;
+    for (; j + 17 <= Length; j += 16)
+    {
+        const __m128i* Block = reinterpret_cast<const __m128i*>(Text + j);
+        const __m128i* Next = reinterpret_cast<const __m128i*>(Text + j + 1);
+        __m128i Hits = _mm_cmpeq_epi8(_mm_loadu_si128(Block), Firsts);
+        if (Pair)
+            Hits = _mm_and_si128(Hits, _mm_cmpeq_epi8(_mm_loadu_si128(Next), Seconds));
+        int Mask = _mm_movemask_epi8(Hits);
+        if (Mask)
+            return j + __builtin_ctz(Mask);
+    }
+    return CandidateScanScalar(Text, j, Length, First, Second, Pair);
+}
+
+// The same with 32 positions per step
+__attribute__((target("avx2"))) size_t CandidateScanAvx2(const char* Text, size_t From,
+                                                         size_t Length, char First, char Second,
+                                                         bool Pair)
+{
+    const __m256i Firsts = _mm256_set1_epi8(First);
+    const __m256i Seconds = _mm256_set1_epi8(Second);
+    size_t j = From;
+    for (; j + 33 <= Length; j += 32)
+    {
+        const __m256i* Block = reinterpret_cast<const __m256i*>(Text + j);
+        const __m256i* Next = reinterpret_cast<const __m256i*>(Text + j + 1);
+        __m256i Hits = _mm256_cmpeq_epi8(_mm256_loadu_si256(Block), Firsts);
+        if (Pair)
+            Hits = _mm256_and_si256(Hits, _mm256_cmpeq_epi8(_mm256_loadu_si256(Next), Seconds));
+        uint32_t Mask = _mm256_movemask_epi8(Hits);
+        if (Mask)
+            return j + __builtin_ctz(Mask);
+    }
+    return CandidateScanSse2(Text, j, Length, First, Second, Pair);
+}
+#endif
+
+// Candidate scan by name (scalar, sse2, avx2), the widest one the processor
+// supports for "auto", null if the name is unknown or not supported
+CandidateScan FindCandidateScan(const string& Name)
+{
+#ifdef KMP_X86
+    __builtin_cpu_init();
+    bool Avx2 = __builtin_cpu_supports("avx2");
+    bool Sse2 = __builtin_cpu_supports("sse2");  // always there on x86-64, not on every i386
+
+    if (Name == "avx2" || (Name == "auto" && Avx2))
+        return Avx2 ? CandidateScanAvx2 : nullptr;
+    if (Name == "sse2" || (Name == "auto" && Sse2))
+        return Sse2 ? CandidateScanSse2 : nullptr;
+#endif
+    if (Name == "scalar" || Name == "auto")
+        return CandidateScanScalar;
+    return nullptr;
+}
+
+// KMP matcher for one pattern: the prefix table is computed once, then the
+// matcher searches any number of texts, chunks, streams or files with it.
+// Texts are taken as string_view and never copied; positions are 64-bit.
+class KmpMatcher
+{
+public:
+    explicit KmpMatcher(string_view FirstLine)
+        : FirstLine(FirstLine), p(CalculatingPrefixFunction(FirstLine)),
+          Scan(FindCandidateScan("auto")) {}
+
+    const string& Pattern() const { return FirstLine; }
+
+    void SetScan(CandidateScan Kernel) { Scan = Kernel; }
+
+    // Feeds one chunk of text into the search
+    // Input:
+    //    Chunk - next piece of the text
+    //    State - state left by the previous chunk, updated for the next one
+    //    Found - called with the starting offset of every match
+    template <class Callback>
+    void Feed(string_view Chunk, KmpState& State, Callback Found) const
+    {
+        const char* Pattern = FirstLine.data();
+        const size_t* Prefixes = p.data();
+        size_t PatternLength = FirstLine.size();
+        size_t FirstLineStep = State.FirstLineStep;
+        if (PatternLength == 0)
+            return;
+        bool Pair = PatternLength >= 2;
+        char Second = Pair ? Pattern[1] : 0;
+
+        for (size_t ChunkStep = 0; ChunkStep < Chunk.size(); ++ChunkStep)
+        {
+            // Outside of a partial match, jump over the bytes that cannot start one
+            if (FirstLineStep == 0 && Chunk[ChunkStep] != Pattern[0])
+            {
+                ChunkStep =
+                    Scan(Chunk.data(), ChunkStep + 1, Chunk.size(), Pattern[0], Second, Pair);
+                if (ChunkStep == Chunk.size())
+                    break;
+            }
+
+            // While mismatch occurs, use prefix table to skip ahead
+            while (FirstLineStep > 0 && Pattern[FirstLineStep] != Chunk[ChunkStep])
+                FirstLineStep = Prefixes[FirstLineStep - 1];
+
+            // If characters match, move to next character in pattern
+            if (Pattern[FirstLineStep] == Chunk[ChunkStep])
+                FirstLineStep++;
+
+            // If entire pattern matched, report the starting offset and fall back
+            // to the longest border, so the pattern is never indexed past its end
+            if (FirstLineStep == PatternLength)
+            {
+                Found(State.Offset + ChunkStep + 1 - PatternLength);
+                FirstLineStep = Prefixes[PatternLength - 1];
+            }
+        }
+
+        State.FirstLineStep = FirstLineStep;
+        State.Offset += Chunk.size();
+    }
+
+    // Searches a whole text, Found is called with the position of each match
+    // Output: number of matches
+    template <class Callback>
+    uint64_t Search(string_view Text, Callback Found) const
+    {
+        KmpState State;
+        uint64_t Matches = 0;
+        Feed(Text, State,
+             [&](uint64_t Start)
+             {
+                 Matches++;
+                 Found(Start);
+             });
+        return Matches;
+    }
+
+    // Searches the text read from Input in chunks of ChunkSize bytes,
+    // so memory stays O(pattern + chunk) for any length of the text
+    // Output: number of matches
+    template <class Callback>
+    uint64_t SearchStream(FILE* Input, size_t ChunkSize, Callback Found) const
+    {
+        vector<char> Chunk(ChunkSize);
+        KmpState State;
+        uint64_t Matches = 0;
+
+        size_t ChunkLength;
+        while ((ChunkLength = fread(Chunk.data(), 1, ChunkSize, Input)) > 0)
+        {
+            Feed(string_view(Chunk.data(), ChunkLength), State,
+                 [&](uint64_t Start)
+                 {
+                     Matches++;
+                     Found(Start);
+                 });
+        }
+        return Matches;
+    }
+
+private:
+    string FirstLine;    // Pattern to search for
+    vector<size_t> p;    // Its prefix table
+    CandidateScan Scan;  // Prefilter of the candidate starts
+};
+
+// Read-only mapping of a whole file, searched in place without a copy.
+// One mapping serves any number of matchers.
+class MappedFile
+{
+public:
+    explicit MappedFile(const string& Path)
+    {
+        int File = open(Path.c_str(), O_RDONLY);
+        if (File < 0)
+            return;
+        struct stat Status;
+        if (fstat(File, &Status) == 0 && S_ISREG(Status.st_mode))
+        {
+            Opened = true;
+            Size = Status.st_size;
+            if (Size > 0)
+            {
+                Data = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, File, 0);
+                if (Data == MAP_FAILED)
+                {
+                    Data = nullptr;
+                    Opened = false;
+                }
+                else
+                    madvise(Data, Size, MADV_SEQUENTIAL);
+            }
+        }
+        close(File);
+    }
+
+    ~MappedFile()
+    {
+        if (Data != nullptr)
+            munmap(Data, Size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file could not be opened or is not a regular file
+    bool IsOpen() const { return Opened; }
+
+    string_view Text() const
+    {
+        return Data != nullptr ? string_view(static_cast<const char*>(Data), Size) : string_view();
+    }
+
+private:
+    void* Data = nullptr;
+    size_t Size = 0;
+    bool Opened = false;
+};
+
 // KMP pattern matching algorithm to find all occurrences of FirstLine in SecondLine
 // Input:
 //    FirstLine - pattern to search for
 //    SecondLine - text to search in
-// Output:
-//    Result - vector containing starting indices of all matches
-void KnuthMorrisPratt(string FirstLine, string SecondLine, vector<int>& Result)
+//    Result - vector to store starting positions of matches
+void KnuthMorrisPratt(string_view FirstLine, string_view SecondLine, vector<uint64_t>& Result)
+{
+    KmpMatcher Matcher(FirstLine);
+    Matcher.Search(SecondLine, [&](uint64_t Start) { Result.push_back(Start); });
+}
+
+// Writes match positions as a comma-separated list through a buffer,
+// so a large number of matches does not mean one write per match
+class MatchWriter
 {
-    // Compute prefix function for pattern with special delimiter ' '
-    vector<int> p = CalculatingPrefixFunction(FirstLine + " ");
-    int FirstLineStep = 0;  // Current position in pattern
+public:
+    MatchWriter(FILE* Output) : Output(Output) {}
+
+    ~MatchWriter() { Flush(); }
 
-    // Iterate through each character in the text
-    for (int SecondLineStep = 0; SecondLineStep < SecondLine.size(); ++SecondLineStep)
+    void Write(uint64_t Position)
     {
-        // While mismatch occurs, use prefix table to skip ahead
-        while (FirstLineStep > 0 && FirstLine[FirstLineStep] != SecondLine[SecondLineStep])
-            FirstLineStep = p[FirstLineStep - 1];
-        
-        // If characters match, move to next character in pattern
-        if (FirstLine[FirstLineStep] == SecondLine[SecondLineStep])
-            FirstLineStep++;
+        if (Count++ > 0)
+            Buffer += ',';
+        Buffer += to_string(Position);
+        if (Buffer.size() >= BUFFER_SIZE)
+            Flush();
+    }
 
-        // If entire pattern matched, record the starting position
-        if (FirstLineStep == FirstLine.size())
-            Result.push_back(SecondLineStep - FirstLine.size() + 1);
+    void Flush()
+    {
+        fwrite(Buffer.data(), 1, Buffer.size(), Output);
+        Buffer.clear();
+        fflush(Output);
     }
-}
 
-int main()
+private:
+    static const size_t BUFFER_SIZE = 1 << 16;
+
+    FILE* Output;
+    string Buffer;
+    uint64_t Count = 0;
+};
+
+int main(int argc, char* argv[])
 {
-    vector<int> Result;  // Stores starting positions of all matches
+    // Both modes below take --scan NAME (auto, avx2, sse2, scalar), the candidate scan kernel
+    CandidateScan Scan = FindCandidateScan("auto");
+    vector<string> Arguments;
+    for (int i = 1; i < argc; i++)
+    {
+        if (string(argv[i]) == "--scan" && i + 1 < argc)
+        {
+            Scan = FindCandidateScan(argv[++i]);
+            if (Scan == nullptr)
+            {
+                cerr << "Unknown or unsupported scan " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else
+            Arguments.push_back(argv[i]);
+    }
+
+    // Streaming mode: kmp --stream PATTERN [FILE] [--chunk BYTES]
+    // searches the whole content of FILE (stdin if it is missing or "-")
+    if (Arguments.size() >= 2 && Arguments[0] == "--stream")
+    {
+        string Path = "-";
+        size_t ChunkSize = 1 << 16;
+        for (size_t i = 2; i < Arguments.size(); i++)
+        {
+            const string& Option = Arguments[i];
+            if (Option == "--chunk" && i + 1 < Arguments.size())
+                ChunkSize = stoull(Arguments[++i]);
+            else
+                Path = Option;
+        }
+        KmpMatcher Matcher(Arguments[1]);
+        Matcher.SetScan(Scan);
+        if (Matcher.Pattern().empty() || ChunkSize == 0)
+        {
+            cerr << "Pattern and chunk size must not be empty" << endl;
+            return 1;
+        }
+
+        FILE* Input = Path == "-" ? stdin : fopen(Path.c_str(), "rb");
+        if (Input == nullptr)
+        {
+            cerr << "Cannot open " << Path << endl;
+            return 1;
+        }
+
+        MatchWriter Writer(stdout);
+        uint64_t Matches =
+            Matcher.SearchStream(Input, ChunkSize, [&](uint64_t Start) { Writer.Write(Start); });
+        if (Input != stdin)
+            fclose(Input);
+        if (!Matches)
+            fputs("-1", stdout);  // No matches found
+        return 0;
+    }
+
+    // Mapped mode: kmp --mmap FILE PATTERN...
+    // maps FILE once and searches it in place for every pattern, one line of output each
+    if (Arguments.size() >= 3 && Arguments[0] == "--mmap")
+    {
+        MappedFile File(Arguments[1]);
+        if (!File.IsOpen())
+        {
+            cerr << "Cannot map " << Arguments[1] << endl;
+            return 1;
+        }
+
+        for (size_t i = 2; i < Arguments.size(); i++)
+        {
+            KmpMatcher Matcher(Arguments[i]);
+            Matcher.SetScan(Scan);
+            uint64_t Matches = 0;
+            {
+                MatchWriter Writer(stdout);
+                Matches = Matcher.Search(File.Text(), [&](uint64_t Start) { Writer.Write(Start); });
+            }
+            if (!Matches)
+                fputs("-1", stdout);  // No matches found
+            fputc('\n', stdout);
+        }
+        return 0;
+    }
+
+    vector<uint64_t> Result;  // Stores starting positions of all matches
     string FirstLine, SecondLine;
     
     // Read input strings
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Lower bounds on the number of squares still needed to cover the free cells of a partial tiling.
+// Every free cell lies in column `column` or to the right of it, and so does every square placed later.
+// A bound must never overestimate, otherwise the search loses optimal tilings.
+// Only estimates below `enough` matter to the caller, so a bound may stop as soon as it reaches it.
+struct LowerBound {
+    const char* name;
+    int (*remaining)(const Occupancy& occupancy, int remainingArea, int column, int enough);
+};
+
+// Free area divided by the area of the largest square that still fits between the column and the right edge
+// (and into the height of the grid). It takes O(1) time, so it has no use for `enough`.
+int areaBound(const Occupancy& occupancy, int remainingArea, int column, int = 0) {
+    int maxPossibleSize = min(occupancy.width - column, occupancy.height);
+    return (remainingArea + maxPossibleSize * maxPossibleSize - 1) / (maxPossibleSize * maxPossibleSize);
+}
+
+// Free cells of a column (or a row) split into uncovered segments by occupied cells.
+// A square meets a column in one contiguous piece, so each segment needs its own squares,
+// and a segment longer than the largest possible square needs several of them.
+int segmentBound(const Occupancy& occupancy, int remainingArea, int column, int enough) {
+
+    int maxPossibleSize = min(occupancy.width - column, occupancy.height);
+    uint64_t full = Occupancy::span(0, occupancy.height);
+
+    // The area bound is much cheaper, try it first.
+    int needed = areaBound(occupancy, remainingArea, column);
+    if (needed >= enough)
+        return needed;
+
+    // Segment counts of all rows at once, one bit plane per binary digit (bit y of plane i is digit i of row y).
+    const int PLANES = 6;
+    uint64_t rowSegments[PLANES] = {};
+
+    uint64_t previousFree = 0; // free cells of the column on the left (the one before `column` is full)
+    for (int x = column; x < occupancy.width; x++) {
+        uint64_t freeCells = ~occupancy.columns[x] & full;
+
+        // A column equal to its left neighbour starts no row segments and has the same column segments.
+        if (freeCells == previousFree)
+            continue;
+
+        // Segments of the column start at free cells whose upper neighbour is occupied.
+        uint64_t columnStarts = freeCells & ~(freeCells << 1);
+        int columnNeeded = __builtin_popcountll(columnStarts);
+
+        // Only segments longer than the largest possible square need more than one of them.
+        if (__builtin_popcountll(freeCells) > maxPossibleSize) {
+            columnNeeded = 0;
+            for (uint64_t starts = columnStarts; starts; starts &= starts - 1) {
+                int y = __builtin_ctzll(starts);
+                uint64_t rest = ~(freeCells >> y);
+                int length = rest ? __builtin_ctzll(rest) : 64 - y;
+                columnNeeded += (length + maxPossibleSize - 1) / maxPossibleSize;
+            }
+        }
+        needed = max(needed, columnNeeded);
+        if (needed >= enough)
+            return needed;
+
+        // Segments of a row start at free cells whose left neighbour is occupied:
+        // add one to the counter of every such row.
+        uint64_t carry = freeCells & ~previousFree;
+        for (int plane = 0; plane < PLANES && carry; plane++) {
+            uint64_t sum = rowSegments[plane] ^ carry;
+            carry &= rowSegments[plane];
+            rowSegments[plane] = sum;
+        }
+
+        previousFree = freeCells;
+    }
+
+    // Largest row counter: walk the planes from the top, keeping the rows that have each digit set.
+    uint64_t rows = full;
+    int rowNeeded = 0;
+    for (int plane = PLANES - 1; plane >= 0; plane--) {
+        if (rows & rowSegments[plane]) {
+            rows &= rowSegments[plane];
+            rowNeeded |= 1 << plane;
+        }
+    }
+
+    return max(needed, rowNeeded);
+}
+
+const LowerBound BOUNDS[] = {
+    { "area", areaBound },
+    { "segments", segmentBound },
+};
+
+// Find a bound by its name, null if there is no such bound
+const LowerBound* findBound(const string& name) {
+    for (const auto& bound : BOUNDS) {
+        if (name == bound.name)
+            return &bound;
+    }
+    return nullptr;
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Occupancy map of the grid (a square or a rectangle) kept alongside the placement stack.
+// Every column is a bitmask of its occupied cells (bit y set = cell (x, y) is taken),
+// so cell probes, free-cell scans and square fitting work on whole words instead of
+// walking the list of placed squares.
+struct Occupancy {
+
+    static const int MAX_SIZE = 64; // one column has to fit into a single 64-bit word
+
+    int width; // number of columns
+    int height; // number of cells in a column
+    vector<uint64_t> columns; // occupied cells of each column
+
+    Occupancy(int size = 0) : Occupancy(size, size) {}
+
+    Occupancy(int width, int height) : width(width), height(height), columns(width, 0) {}
+
+    // Mask with bits [y, y + length) set
+    static uint64_t span(int y, int length) {
+        uint64_t bits = length >= 64 ? ~0ULL : (1ULL << length) - 1;
+        return bits << y;
+    }
+
+    // Check if the cell (x, y) is free
+    bool isFree(int x, int y) const {
+        return !((columns[x] >> y) & 1);
+    }
+
+    // Mark the cells of the square as occupied
+    void place(int x, int y, int length) {
+        uint64_t mask = span(y, length);
+        for (int column = x; column < x + length; column++)
+            columns[column] |= mask;
+    }
+
+    // Release the cells of the square (undo of place)
+    void remove(int x, int y, int length) {
+        uint64_t mask = ~span(y, length);
+        for (int column = x; column < x + length; column++)
+            columns[column] &= mask;
+    }
+
+    // Find the first free cell starting from (x, y), scanning column by column.
+    // Returns false if every cell from (x, y) on is occupied.
+    bool nextFree(int& x, int& y) const {
+        uint64_t full = span(0, height);
+
+        for (int column = x; column < width; column++) {
+            uint64_t freeCells = ~columns[column] & full;
+            if (column == x)
+                freeCells &= full << y;
+
+            if (freeCells) {
+                x = column;
+                y = __builtin_ctzll(freeCells);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Find the side of the largest square with the top-left corner at the free cell (x, y)
+    int maxSquare(int x, int y) const {
+
+        // The square cannot extend beyond the grid.
+        int maxSizeOfSquare = min(width - x, height - y);
+
+        // Every column the square covers limits its size by the first occupied cell below y.
+        for (int column = x; column < x + maxSizeOfSquare; column++) {
+            uint64_t below = columns[column] >> y;
+            if (below) {
+                // Squares wider than (column - x) reach this column and must stop above the occupied cell.
+                int freeHeight = __builtin_ctzll(below);
+                maxSizeOfSquare = min(maxSizeOfSquare, max(column - x, freeHeight));
+            }
+        }
+
+        return maxSizeOfSquare;
+    }
+};
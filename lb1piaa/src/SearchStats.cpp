@@ -0,0 +1,44 @@
+#include <algorithm>
+
+using namespace std;
+
+// Reasons for cutting a branch of the squaring search
+enum PruneReason {
+    PRUNE_COUNT, // the squares placed so far already reach the best solution
+    PRUNE_BOUND, // the lower bound on the squares still needed is too high
+    PRUNE_TABLE, // the transposition table knows the shape needs too many squares
+    PRUNE_REASONS
+};
+
+const char* const PRUNE_REASON_NAMES[PRUNE_REASONS] = { "count", "bound", "table" };
+
+// Statistics policy of Table that records nothing.
+// All calls are empty inline functions, so the production build contains no counters at all.
+struct NoStats {
+    void node(int) {}
+    void prune(PruneReason) {}
+    void merge(const NoStats&) {}
+};
+
+// Statistics policy of Table that counts what every search does
+struct SearchStats {
+    long long nodes = 0; // nodes expanded by the exact search (warm start probes not included)
+    long long prunes[PRUNE_REASONS] = {}; // branches cut, by reason
+    int maxDepth = 0; // largest number of squares on the placement stack
+
+    void node(int depth) {
+        nodes++;
+        maxDepth = max(maxDepth, depth);
+    }
+
+    void prune(PruneReason reason) {
+        prunes[reason]++;
+    }
+
+    void merge(const SearchStats& other) {
+        nodes += other.nodes;
+        for (int reason = 0; reason < PRUNE_REASONS; reason++)
+            prunes[reason] += other.prunes[reason];
+        maxDepth = max(maxDepth, other.maxDepth);
+    }
+};
@@ -0,0 +1,122 @@
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Optimal tiling of a prime grid, in grid cells (x, y, size)
+struct KnownTiling {
+    int size;
+    int count;
+    int squares[16][3];
+};
+
+// Tilings of the small primes found by Table itself, so any grid whose smallest prime factor is
+// listed here is answered without a search.
+constexpr KnownTiling KNOWN_TILINGS[] = {
+    { 2, 4, { { 0, 0, 1 }, { 0, 1, 1 }, { 1, 0, 1 }, { 1, 1, 1 } } },
+    { 3, 6, { { 0, 0, 2 }, { 0, 2, 1 }, { 2, 0, 1 }, { 1, 2, 1 }, { 2, 1, 1 }, { 2, 2, 1 } } },
+    { 5, 8, { { 0, 0, 3 }, { 0, 3, 2 }, { 3, 0, 2 }, { 2, 3, 2 }, { 3, 2, 1 }, { 4, 2, 1 }, { 4, 3, 1 }, { 4, 4, 1 } } },
+    { 7, 9, { { 0, 0, 4 }, { 0, 4, 3 }, { 4, 0, 3 }, { 3, 4, 2 }, { 3, 6, 1 }, { 4, 3, 1 }, { 4, 6, 1 }, { 5, 3, 2 }, { 5, 5, 2 } } },
+    { 11, 11, { { 0, 0, 6 }, { 0, 6, 5 }, { 6, 0, 5 }, { 5, 6, 3 }, { 5, 9, 2 }, { 6, 5, 1 }, { 7, 5, 1 }, { 7, 9, 1 }, { 7, 10, 1 }, { 8, 5, 3 }, { 8, 8, 3 } } },
+    { 13, 11, { { 0, 0, 7 }, { 0, 7, 6 }, { 7, 0, 6 }, { 6, 7, 2 }, { 6, 9, 4 }, { 7, 6, 1 }, { 8, 6, 3 }, { 10, 9, 1 }, { 10, 10, 3 }, { 11, 6, 2 }, { 11, 8, 2 } } },
+    { 17, 12, { { 0, 0, 9 }, { 0, 9, 8 }, { 9, 0, 8 }, { 8, 9, 2 }, { 8, 11, 4 }, { 8, 15, 2 }, { 9, 8, 1 }, { 10, 8, 3 }, { 10, 15, 2 }, { 12, 11, 1 }, { 12, 12, 5 }, { 13, 8, 4 } } },
+    { 19, 13, { { 0, 0, 10 }, { 0, 10, 9 }, { 10, 0, 9 }, { 9, 10, 3 }, { 9, 13, 6 }, { 10, 9, 1 }, { 11, 9, 1 }, { 12, 9, 4 }, { 15, 13, 1 }, { 15, 14, 1 }, { 15, 15, 4 }, { 16, 9, 3 }, { 16, 12, 3 } } },
+    { 23, 13, { { 0, 0, 12 }, { 0, 12, 11 }, { 12, 0, 11 }, { 11, 12, 2 }, { 11, 14, 5 }, { 11, 19, 4 }, { 12, 11, 1 }, { 13, 11, 3 }, { 15, 19, 1 }, { 15, 20, 3 }, { 16, 11, 7 }, { 16, 18, 2 }, { 18, 18, 5 } } },
+    { 29, 14, { { 0, 0, 15 }, { 0, 15, 14 }, { 15, 0, 14 }, { 14, 15, 2 }, { 14, 17, 5 }, { 14, 22, 7 }, { 15, 14, 1 }, { 16, 14, 3 }, { 19, 14, 3 }, { 19, 17, 3 }, { 19, 20, 2 }, { 21, 20, 1 }, { 21, 21, 8 }, { 22, 14, 7 } } },
+    { 31, 15, { { 0, 0, 16 }, { 0, 16, 15 }, { 16, 0, 15 }, { 15, 16, 3 }, { 15, 19, 6 }, { 15, 25, 6 }, { 16, 15, 1 }, { 17, 15, 1 }, { 18, 15, 4 }, { 21, 19, 1 }, { 21, 20, 1 }, { 21, 21, 10 }, { 22, 15, 6 }, { 28, 15, 3 }, { 28, 18, 3 } } },
+    { 37, 15, { { 0, 0, 19 }, { 0, 19, 18 }, { 19, 0, 18 }, { 18, 19, 2 }, { 18, 21, 5 }, { 18, 26, 11 }, { 19, 18, 1 }, { 20, 18, 3 }, { 23, 18, 8 }, { 29, 26, 3 }, { 29, 29, 8 }, { 31, 18, 6 }, { 31, 24, 1 }, { 31, 25, 1 }, { 32, 24, 5 } } },
+};
+
+// Optimal tilings of simplified grids, keyed by the grid size.
+// Every grid is simplified to its smallest prime factor, so one entry answers all of its multiples.
+// Tilings found by the search can be kept in a text file, one grid per line: "size count x y size x y size ...".
+class SolutionCache {
+
+private:
+
+    string path; // cache file, empty if the cache lives in memory only
+    map<int, vector<Square>> tilings;
+
+public:
+
+    SolutionCache(const string& path = "") : path(path) {
+
+        for (const auto& known : KNOWN_TILINGS) {
+            vector<Square>& squares = tilings[known.size];
+            for (int i = 0; i < known.count; i++)
+                squares.push_back(Square(known.squares[i][0], known.squares[i][1], known.squares[i][2]));
+        }
+
+        if (!path.empty())
+            load();
+    }
+
+    // Copy the cached tiling of the simplified grid into squares, returns false on a miss
+    bool find(int gridSize, vector<Square>& squares) const {
+        auto entry = tilings.find(gridSize);
+        if (entry == tilings.end())
+            return false;
+
+        squares = entry->second;
+        return true;
+    }
+
+    // Remember the tiling of the simplified grid and append it to the cache file
+    void store(int gridSize, const vector<Square>& squares) {
+        if (!tilings.emplace(gridSize, squares).second || path.empty())
+            return;
+
+        ofstream file(path, ios::app);
+        file << gridSize << " " << squares.size();
+        for (const auto& square : squares)
+            file << " " << square.x << " " << square.y << " " << square.size;
+        file << "\n";
+    }
+
+private:
+
+    // Read the cache file, a missing file is an empty cache.
+    // A line that is not a valid tiling (stale or corrupted) is skipped.
+    void load() {
+        ifstream file(path);
+
+        string line;
+        while (getline(file, line)) {
+            istringstream entry(line);
+            int gridSize, count;
+            if (!(entry >> gridSize >> count) || gridSize < 1 || gridSize > Occupancy::MAX_SIZE ||
+                count < 1 || count > gridSize * gridSize)
+                continue;
+
+            vector<Square> squares(count);
+            for (auto& square : squares)
+                entry >> square.x >> square.y >> square.size;
+
+            if (entry && isTiling(gridSize, squares))
+                tilings.emplace(gridSize, squares);
+        }
+    }
+
+    // Check that the squares lie inside the grid, are smaller than it, do not overlap and cover it
+    static bool isTiling(int gridSize, const vector<Square>& squares) {
+        Occupancy occupancy(gridSize);
+        int area = 0;
+        for (const auto& square : squares) {
+            if (square.size < 1 || (gridSize > 1 && square.size >= gridSize) || square.x < 0 ||
+                square.y < 0 || square.x + square.size > gridSize || square.y + square.size > gridSize)
+                return false;
+
+            uint64_t cells = Occupancy::span(square.y, square.size);
+            for (int column = square.x; column < square.x + square.size; column++)
+                if (occupancy.columns[column] & cells)
+                    return false;
+
+            occupancy.place(square.x, square.y, square.size);
+            area += square.size * square.size;
+        }
+        return area == gridSize * gridSize;
+    }
+};
@@ -1,25 +1,19 @@
+#include <type_traits>
+
 struct Square {
 
 public:
 
-    const int trailing; // right boundary (edge)
-    const int bottom; // bottom boundary (edge)
     int x, y, size; // x-axis / y-axis positions / length of a square
 
+    Square() = default;
+
     // Constructor
-    Square(int x, int y, int size) : x(x), y(y), size(size), trailing(x + size), bottom(y + size) {}
+    Square(int x, int y, int size) : x(x), y(y), size(size) {}
 
-    // A copy constructor
-    Square(const Square& other)
-        : x(other.x), y(other.y), size(other.size), trailing(other.trailing), bottom(other.bottom) {
-    }
+    int trailing() const { return x + size; } // right boundary (edge)
+    int bottom() const { return y + size; } // bottom boundary (edge)
+};
 
-    Square& operator=(const Square& other) {
-        if (this != &other) {
-            x = other.x;
-            y = other.y;
-            size = other.size;
-        }
-        return *this;
-    }
-};
\ No newline at end of file
+// The placement stack copies squares around on every new best solution
+static_assert(std::is_trivially_copyable<Square>::value, "Square must stay trivially copyable");
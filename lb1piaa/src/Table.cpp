@@ -1,16 +1,74 @@
 #include <vector>
 #include "Square.cpp"
+#include "Occupancy.cpp"
+#include "WorkStealingPool.cpp"
+#include "SolutionCache.cpp"
+#include "Bounds.cpp"
+#include "TranspositionTable.cpp"
+#include "SearchStats.cpp"
+#include "Trace.cpp"
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
 
 using namespace std;
 
-class Table {
+// Square tiling solver for square grids and N x M rectangles.
+// The Stats policy decides what the search records about itself:
+// NoStats (the Table used by main) compiles to nothing, SearchStats counts nodes, prunes and depth.
+// The Trace policy decides which steps of the search are written to a TraceSink:
+// NoTrace compiles to nothing, BestTrace writes the improving solutions, NodeTrace every square tried.
+template <class Stats = NoStats, class Trace = NoTrace>
+class BasicTable {
 
 private:
 
+    // State of one depth-first search: placement stack and occupied cells of the current partial solution.
+    // Every worker thread owns one, so the hot path never touches shared data except the incumbent.
+    struct Search {
+        vector<Square> placed; // placement stack of the current partial solution
+        Occupancy occupancy; // occupied cells of the current partial solution
+        unsigned task; // index of the subtree being explored (its position in depth-first order)
+        long long nodes; // number of nodes expanded by this search
+        TranspositionTable table; // bounds proven for shapes this search has finished exploring
+        uint64_t hash; // hash of the occupied cells, maintained only while the table is enabled
+        Stats stats; // what this search has done since its task started
+    };
+
+    // Root of a subtree handed to a worker: the squares placed on the way to it.
+    struct Task {
+        vector<Square> squares;
+        int occupiedArea;
+    };
+
+    static const unsigned NO_TASK = 0xffffffffu;
+
+    // Shapes that have to be finished with fewer squares than this are cheaper to re-explore
+    // than to look up in the transposition table.
+    static const int TABLE_MIN_REMAINING = 5;
+
     int squareSize;
-    int gridSize;
-    int bestCount;
+    int width; // columns of the grid
+    int height; // rows of the grid
+    int threadCount;
+    SolutionCache* cache; // optimal tilings of simplified grids, may be null
+    const LowerBound* bound; // estimate of the squares still needed, used for pruning
+    bool iterativeDeepening; // search for k squares with k = 1, 2, ... instead of improving an incumbent
+    int warmStartRuns; // randomized probes run before the search to get an initial incumbent, 0 to skip
+    size_t tableBytes; // memory of the transposition tables of all workers together, 0 to disable them
+    long long nodeTotal; // nodes expanded by all searches, guarded by bestLock
+    Stats statsTotal; // statistics of all searches, guarded by bestLock
+    Trace trace; // steps of the search written to the trace sink
+    vector<Search> searches; // one per worker, kept between the rounds of iterative deepening
+
+    // Incumbent shared by all workers: best count in the upper half, the task that found it in the lower half.
+    // Of two solutions with the same count the one from the earlier task wins, which is the one
+    // the sequential search would have kept, so the printed tiling does not depend on the thread count.
+    atomic<uint64_t> incumbent;
+    mutex bestLock; // guards bestSolution
     vector<Square> bestSolution;
 
 public:
@@ -19,165 +77,467 @@ public:
     void placeSquares() {
 
         simplifyGrid();
-        int startX = gridSize / 2;
-        int startY = (gridSize + 1) / 2;
 
-        vector<Square> squares = { Square(0, 0, startY), Square(0, startY, startX), Square(startY, 0, startX) };
+        // The simplified side of a square grid is the smallest prime factor of the original one, so
+        // a tiling cached for it just has to be scaled by squareSize. Rectangles are not cached.
+        bool cached = cache != nullptr && width == height;
+        if (cached && cache->find(width, bestSolution)) {
+            incumbent.store(pack(bestSolution.size(), 0));
+            trace.seed(width, height, squareSize);
+            trace.best(bestSolution.data(), bestSolution.size());
+            return;
+        }
 
-        int occupiedArea = pow(startY, 2) + 2 * pow(startX, 2);
+        search();
 
-        backtrack(squares, occupiedArea, 3, startX, startY);
+        if (cached)
+            cache->store(width, bestSolution);
     }
 
     // Print the result (best solution)
     void printResult() {
 
-        cout << bestCount << endl;
+        cout << bestCount() << endl;
         for (const auto& square : bestSolution) {
             cout << square.x * squareSize + 1 << " " << square.y * squareSize + 1 << " "
                 << square.size * squareSize << endl;
         }
     }
 
-    Table(int gridSize) : gridSize(gridSize), bestCount(gridSize* gridSize + 1) {}
+    // Solver for a square grid
+    BasicTable(int gridSize, int threadCount = 1, SolutionCache* cache = nullptr)
+        : BasicTable(gridSize, gridSize, threadCount, cache) {}
+
+    // Solver for a width x height rectangle
+    BasicTable(int width, int height, int threadCount, SolutionCache* cache)
+        : width(width), height(height), threadCount(threadCount < 1 ? 1 : threadCount), cache(cache),
+          bound(&BOUNDS[0]), iterativeDeepening(false), warmStartRuns(32), tableBytes(0), nodeTotal(0),
+          incumbent(pack(width * height + 1, NO_TASK)) {}
+
+    void setBound(const LowerBound* lowerBound) { bound = lowerBound; }
+
+    void setIterativeDeepening(bool enabled) { iterativeDeepening = enabled; }
+
+    void setWarmStart(int runs) { warmStartRuns = runs; }
+
+    void setTableMemory(size_t bytes) { tableBytes = bytes; }
+
+    // Write the trace to the sink (ignored by NoTrace)
+    void setTrace(TraceSink* sink) { trace.attach(sink); }
+
+    // Number of nodes expanded by the last search (0 if the tiling came from the cache)
+    long long nodeCount() const { return nodeTotal; }
+
+    // Statistics of the exact search, recorded only by an instrumented Stats policy
+    const Stats& stats() const { return statsTotal; }
+
+    // Number of squares in the best solution (valid after placeSquares)
+    int squareCount() const { return bestCount(); }
+
+    // Length of the side of the grid after simplification, the width for a rectangle (valid after placeSquares)
+    int simplifiedSize() const { return width; }
+
+    // Check if the simplified grid fits into the occupancy map
+    static bool isSupported(int gridSize) {
+        return gridSize >= 2 && gridSize / largestDivisor(gridSize) <= Occupancy::MAX_SIZE;
+    }
+
+    static bool isSupported(int width, int height) {
+        if (width == height)
+            return isSupported(width);
+        if (width < 1 || height < 1)
+            return false;
+
+        int divisor = gcd(width, height);
+        return width / divisor <= Occupancy::MAX_SIZE && height / divisor <= Occupancy::MAX_SIZE;
+    }
 
 private:
 
-    // Explore All other possible position and deteremin the best solution
-    void backtrack(vector<Square> currentSquares, int occupiedArea, int currentCount, int startX, int startY) {
+    // Find the best tiling of the simplified grid
+    void search() {
 
-        // Base case: If the entire grid is occupied, we check if this solution is better than the current best.
-        if (occupiedArea == gridSize * gridSize) {
-            if (currentCount < bestCount) {
-                // Update the best solution if the current solution uses fewer squares.
-                bestCount = currentCount;
-                bestSolution = currentSquares;
+        Task root = width == height ? squareSeed() : Task{ {}, 0 };
+
+        trace.seed(width, height, squareSize);
+
+        bestSolution.reserve(width * height);
+
+        // The tables only hold facts about shapes, so they stay valid for the whole search.
+        searches.assign(threadCount, makeSearch(tableBytes / threadCount));
+
+        if (!iterativeDeepening) {
+            if (width != height)
+                euclidTiling();
+
+            if (warmStartRuns > 0)
+                warmStart(root);
+
+            explore(root);
+            return;
+        }
+
+        // Ask for a tiling with exactly k squares, starting from the lower bound of the seed.
+        // Every smaller k has been refuted by then, so the first tiling found is optimal.
+        Occupancy seed(width, height);
+        for (const auto& square : root.squares)
+            seed.place(square.x, square.y, square.size);
+
+        int x = 0;
+        int y = 0;
+        seed.nextFree(x, y);
+
+        int count = root.squares.size();
+        for (int k = count + bound->remaining(seed, width * height - root.occupiedArea, x, width * height); ; k++) {
+            // Task 0 cannot tie with an incumbent of its own, so every task has to stay below k + 1.
+            incumbent.store(pack(k + 1, 0));
+            explore(root);
+
+            if (bestCount() <= k)
+                break;
+        }
+    }
+
+    // Seed of a square grid: a square of more than half the side in one corner and the two largest
+    // squares next to it. Some optimal tiling of a prime side always contains them.
+    Task squareSeed() const {
+        int startX = width / 2;
+        int startY = (width + 1) / 2;
+
+        return { { Square(0, 0, startY), Square(0, startY, startX), Square(startY, 0, startX) },
+                 startY * startY + 2 * startX * startX };
+    }
+
+    // Seed the incumbent of a rectangle with the tiling that follows Euclid's algorithm on its sides:
+    // cut off the largest squares that fit and go on with the strip that is left.
+    // Stored as if task 0 had found it, like the warm start.
+    void euclidTiling() {
+        int x = 0;
+        int y = 0;
+        int restWidth = width;
+        int restHeight = height;
+
+        bestSolution.clear();
+        while (restWidth > 0 && restHeight > 0) {
+            if (restWidth >= restHeight) {
+                bestSolution.push_back(Square(x, y, restHeight));
+                x += restHeight;
+                restWidth -= restHeight;
+            }
+            else {
+                bestSolution.push_back(Square(x, y, restWidth));
+                y += restWidth;
+                restHeight -= restWidth;
             }
-            return; // Stop further exploration for this branch.
         }
 
-        // Iterate over all possible positions (x, y) in the grid.
-        for (int x = startX; x < gridSize; x++) {
-            for (int y = startY; y < gridSize; y++) {
-                // Skip this position if placing a square here would overlap with existing squares.
-                if (isOverlap(currentSquares, x, y))
-                    continue;
+        incumbent.store(pack(bestSolution.size(), 0));
+        trace.best(bestSolution.data(), bestSolution.size());
+    }
 
-                // Find the maximum possible size of a square that can be placed at (x, y).
-                int maxSizeOfSquare = findMaxSizeSquare(currentSquares, x, y);
+    // Node budget of one warm start probe
+    static const int PROBE_NODES = 10000;
 
-                // If no square can be placed at (x, y), skip this position.
-                if (maxSizeOfSquare <= 0)
-                    continue;
+    // Number of squares after the seed that a probe places in random order
+    static const int PROBE_RANDOM_SQUARES = 3;
 
-                // Try placing squares of all possible sizes, starting from the largest.
-                for (int size = maxSizeOfSquare; size >= 1; size--) {
-                    // Create a new square at (x, y) with the current size.
-                    Square newSquare(x, y, size);
+    // Seed the incumbent with the best tiling found by short searches from random starting points:
+    // each probe picks the first few squares after the seed at random and then runs the usual
+    // largest-first search on a small node budget.
+    // The warm tiling is stored as if task 0 had found it, so only strictly better tilings replace it
+    // and the result still does not depend on the thread count.
+    void warmStart(const Task& root) {
 
-                    // Calculate the new occupied area after placing this square.
-                    int newOccupiedArea = occupiedArea + size * size;
+        mt19937 random(width);
+        Search search = makeSearch();
 
-                    // Calculate the remaining area that still needs to be covered.
-                    int remainingArea = gridSize * gridSize - newOccupiedArea;
+        int count = root.squares.size();
+        for (int i = 0; i < count; i++)
+            push(search, i, root.squares[i]);
 
-                    // If there is remaining area, estimate the minimum number of squares needed to cover it.
-                    if (remainingArea > 0) {
-                        // The maximum possible size of a square that can fit in the remaining area.
-                        int maxPossibleSize = min(gridSize - x, gridSize - y);
+        for (int run = 0; run < warmStartRuns; run++) {
+            search.nodes = 0;
+            probe(search, random, root.occupiedArea, count, count + PROBE_RANDOM_SQUARES);
+            nodeTotal += search.nodes;
+        }
+    }
 
-                        // Estimate the minimum number of squares needed to cover the remaining area.
-                        int minSquaresNeeded =
-                            (remainingArea + (maxPossibleSize * maxPossibleSize) - 1) /
-                            (maxPossibleSize * maxPossibleSize);
+    // Depth-first search that gives up after PROBE_NODES nodes.
+    // Squares up to randomDepth are tried in random order, the deeper ones largest first.
+    void probe(Search& search, mt19937& random, int occupiedArea, int currentCount, int randomDepth) {
 
-                        // If the current solution cannot be better than the best solution, skip this branch.
-                        if (currentCount + 1 + minSquaresNeeded >= bestCount) {
-                            continue;
-                        }
-                    }
+        if (++search.nodes > PROBE_NODES)
+            return;
 
-                    // Add the new square to the current solution.
-                    currentSquares.push_back(newSquare);
-
-                    // If the grid is fully occupied, check if this solution is better than the best solution.
-                    if (newOccupiedArea == gridSize * gridSize) {
-                        if (currentCount + 1 < bestCount) {
-                            // Update the best solution.
-                            bestCount = currentCount + 1;
-                            bestSolution = currentSquares;
-                        }
-                        // Remove the last square and continue exploring other possibilities.
-                        currentSquares.pop_back();
-                        continue;
-                    }
+        int x = 0;
+        int y = 0;
+        search.occupancy.nextFree(x, y);
 
-                    // If the current solution can still be improved, recursively explore further.
-                    if (currentCount + 1 < bestCount) {
-                        backtrack(currentSquares, newOccupiedArea, currentCount + 1, x, y);
-                    }
+        int sizes[Occupancy::MAX_SIZE];
+        int maxSizeOfSquare = search.occupancy.maxSquare(x, y);
+        for (int i = 0; i < maxSizeOfSquare; i++)
+            sizes[i] = maxSizeOfSquare - i;
+        if (currentCount < randomDepth)
+            shuffle(sizes, sizes + maxSizeOfSquare, random);
 
-                    // Remove the last square to backtrack and try other possibilities.
-                    currentSquares.pop_back();
-                }
+        for (int i = 0; i < maxSizeOfSquare; i++) {
+            int size = sizes[i];
+            int newOccupiedArea = occupiedArea + size * size;
+            int limit = bestCount();
+
+            if (currentCount + 1 >= limit)
+                break;
 
-                // After trying all sizes at (x, y), move to the next position.
-                return;
+            push(search, currentCount, Square(x, y, size));
+
+            if (newOccupiedArea == width * height) {
+                bestSolution.assign(search.placed.begin(), search.placed.begin() + currentCount + 1);
+                incumbent.store(pack(currentCount + 1, 0));
+                trace.best(bestSolution.data(), currentCount + 1);
+            }
+            else if (currentCount + 1 + areaBound(search.occupancy, width * height - newOccupiedArea, x) < limit) {
+                probe(search, random, newOccupiedArea, currentCount + 1, randomDepth);
             }
 
-            // Reset startY to 0 after the first row to ensure all positions are explored.
-            startY = 0;
+            pop(search, currentCount);
         }
     }
 
-    // Check if the position (x,y) overlap with existing squares
-    bool isOverlap(const vector<Square>& squares, int x, int y) {
+    // Explore the whole tree below root, on the worker pool if there is more than one thread
+    void explore(const Task& root) {
+
+        if (threadCount == 1) {
+            runTask(searches[0], root, 0);
+            return;
+        }
 
-        for (const auto& square : squares) {
-            if (x >= square.x && x < square.trailing && y >= square.y && y < square.bottom) {
-                return true;
+        // Split the tree into enough subtrees to keep every worker busy and let the pool balance them.
+        vector<Task> tasks = splitTree(root, threadCount * 32);
+
+        WorkStealingPool pool(threadCount);
+
+        pool.run(tasks.size(), [&](int worker, int task) {
+            runTask(searches[worker], tasks[task], task);
+        });
+    }
+
+    static uint64_t pack(int count, unsigned task) {
+        return (uint64_t(count) << 32) | task;
+    }
+
+    int bestCount() const {
+        return int(incumbent.load() >> 32);
+    }
+
+    // Number of squares a solution of the given task has to stay below to replace the incumbent.
+    // Earlier tasks may also tie with it.
+    int countLimit(unsigned task) const {
+        uint64_t best = incumbent.load(memory_order_relaxed);
+        int count = int(best >> 32);
+        return task < unsigned(best & 0xffffffffu) ? count + 1 : count;
+    }
+
+    // Publish a complete tiling of the search if it beats the incumbent
+    void offerSolution(const Search& search, int count) {
+        lock_guard<mutex> guard(bestLock);
+
+        uint64_t candidate = pack(count, search.task);
+        if (candidate < incumbent.load()) {
+            bestSolution.assign(search.placed.begin(), search.placed.begin() + count);
+            incumbent.store(candidate);
+            trace.best(bestSolution.data(), count);
+        }
+    }
+
+    Search makeSearch(size_t tableBytes = 0) const {
+        // A solution never has more squares than cells, so the stack is allocated once for the whole search.
+        return Search{ vector<Square>(width * height), Occupancy(width, height), 0, 0,
+                       TranspositionTable(width, height, tableBytes), 0, Stats() };
+    }
+
+    // Load the subtree root into the search and explore everything below it
+    void runTask(Search& search, const Task& task, unsigned index) {
+
+        search.occupancy = Occupancy(width, height);
+        search.task = index;
+        search.nodes = 0;
+        search.stats = Stats();
+
+        int count = task.squares.size();
+        for (int i = 0; i < count; i++)
+            push(search, i, task.squares[i]);
+
+        // Cells before the first free one are all occupied, so the scan can simply start at the corner.
+        backtrack(search, task.occupiedArea, count, 0, 0);
+
+        for (int i = count - 1; i >= 0; i--)
+            pop(search, i);
+
+        lock_guard<mutex> guard(bestLock);
+        nodeTotal += search.nodes;
+        statsTotal.merge(search.stats);
+    }
+
+    // Expand the tree level by level until there are at least taskCount subtrees (or the levels run out).
+    // Children replace their parent in place, so the list stays in depth-first order.
+    vector<Task> splitTree(const Task& root, int taskCount) {
+
+        vector<Task> level = { root };
+        Search search = makeSearch();
+
+        for (int depth = 0; depth < 8 && int(level.size()) < taskCount; depth++) {
+            vector<Task> next;
+            bool expanded = false;
+
+            for (const auto& task : level) {
+                // A complete tiling has no children and stays a task of its own.
+                if (task.occupiedArea == width * height) {
+                    next.push_back(task);
+                    continue;
+                }
+
+                search.occupancy = Occupancy(width, height);
+                for (const auto& square : task.squares)
+                    search.occupancy.place(square.x, square.y, square.size);
+
+                int x = 0;
+                int y = 0;
+                search.occupancy.nextFree(x, y);
+
+                for (int size = search.occupancy.maxSquare(x, y); size >= 1; size--) {
+                    Task child = task;
+                    child.squares.push_back(Square(x, y, size));
+                    child.occupiedArea += size * size;
+                    next.push_back(child);
+                }
+                expanded = true;
             }
+
+            level.swap(next);
+            if (!expanded)
+                break;
         }
-        return false;
+
+        return level;
     }
 
-    // Find the possible max size for a square
-    int findMaxSizeSquare(const vector<Square>& squares, int x, int y) {
+    // Explore All other possible position and deteremin the best solution
+    // The first currentCount entries of the placement stack hold the current partial solution.
+    void backtrack(Search& search, int occupiedArea, int currentCount, int startX, int startY) {
 
-        // Initialize the maximum possible size of a square that can be placed at (x, y).
-        // This is constrained by the grid boundaries: the square cannot extend beyond the grid.
-        int maxSizeOfSquare = min(gridSize - x, gridSize - y);
+        search.nodes++;
+        search.stats.node(currentCount);
 
-        // Iterate through all existing squares to check if they restrict the size of the new square.
-        for (const auto& square : squares) {
-            // Check if the existing square is to the right and below the position (x, y).
-            // If so, the new square's size is restricted by the distance between y and the existing square's top edge.
-            if (square.trailing > x && square.y > y) {
-                maxSizeOfSquare = min(maxSizeOfSquare, square.y - y);
+        // Base case: If the entire grid is occupied, we check if this solution is better than the current best.
+        if (occupiedArea == width * height) {
+            if (currentCount < countLimit(search.task)) {
+                // Update the best solution if the current solution uses fewer squares.
+                offerSolution(search, currentCount);
             }
-            // Check if the existing square is below and to the right of the position (x, y).
-            // If so, the new square's size is restricted by the distance between x and the existing square's left edge.
-            else if (square.bottom > y && square.x > x) {
-                maxSizeOfSquare = min(maxSizeOfSquare, square.x - x);
+            return; // Stop further exploration for this branch.
+        }
+
+        // Find the first free position (x, y) in the grid, scanning column by column.
+        int x = startX;
+        int y = startY;
+        if (!search.occupancy.nextFree(x, y))
+            return;
+
+        // Find the maximum possible size of a square that can be placed at (x, y).
+        int maxSizeOfSquare = search.occupancy.maxSquare(x, y);
+
+        // Try placing squares of all possible sizes, starting from the largest.
+        for (int size = maxSizeOfSquare; size >= 1; size--) {
+            // Calculate the new occupied area after placing this square.
+            int newOccupiedArea = occupiedArea + size * size;
+
+            // The incumbent may have been improved by another worker since the last size.
+            int limit = countLimit(search.task);
+
+            // Even a square covering everything left cannot beat the best solution.
+            if (currentCount + 1 >= limit) {
+                search.stats.prune(PRUNE_COUNT);
+                break;
+            }
+
+            // Add the new square to the current solution.
+            push(search, currentCount, Square(x, y, size));
+            trace.place(search.task, currentCount, search.placed[currentCount]);
+
+            // If the grid is fully occupied, check if this solution is better than the best solution.
+            if (newOccupiedArea == width * height) {
+                // Update the best solution.
+                offerSolution(search, currentCount + 1);
+            }
+            // If the rest of the grid may still be covered with few enough squares, recursively explore further.
+            else {
+                int enough = limit - currentCount - 1;
+                int remaining = 0;
+
+                // The same shape has been explored before and needed too many squares to finish.
+                bool known = enough >= TABLE_MIN_REMAINING && search.table.enabled() &&
+                             search.table.find(search.hash, remaining);
+
+                if (known && remaining >= enough) {
+                    search.stats.prune(PRUNE_TABLE);
+                }
+                else if (bound->remaining(search.occupancy, width * height - newOccupiedArea, x, enough) >= enough) {
+                    search.stats.prune(PRUNE_BOUND);
+                }
+                else {
+                    long long nodesBefore = search.nodes;
+                    backtrack(search, newOccupiedArea, currentCount + 1, x, y);
+
+                    // Every tiling of the shape below the current limit has been seen by now,
+                    // and any such tiling would have lowered the limit to its own count.
+                    if (enough >= TABLE_MIN_REMAINING && search.table.enabled()) {
+                        search.table.store(search.hash, countLimit(search.task) - currentCount - 1,
+                            search.nodes - nodesBefore);
+                    }
+                }
             }
+
+            // Remove the last square to backtrack and try other possibilities.
+            pop(search, currentCount);
         }
+    }
+
+    // Put the square on top of the placement stack (at index) and occupy its cells
+    static void push(Search& search, int index, const Square& square) {
+        search.placed[index] = square;
+        search.occupancy.place(square.x, square.y, square.size);
 
-        // Return the maximum possible size of the new square that can be placed at (x, y)
-        // without overlapping any existing squares or exceeding the grid boundaries.
-        return maxSizeOfSquare;
+        if (search.table.enabled())
+            search.hash ^= search.table.squareKey(square.x, square.y, square.size);
     }
 
-    void simplifyGrid() {
-        int maxDivisor = 1;
+    // Take the square at index off the placement stack and release its cells
+    static void pop(Search& search, int index) {
+        const Square& square = search.placed[index];
+        search.occupancy.remove(square.x, square.y, square.size);
 
+        if (search.table.enabled())
+            search.hash ^= search.table.squareKey(square.x, square.y, square.size);
+    }
+
+    // Find the largest proper divisor of the grid size
+    static int largestDivisor(int gridSize) {
         for (int i = gridSize / 2; i >= 1; --i) {
-            if (gridSize % i == 0) {
-                maxDivisor = i;
-                break;
-            }
+            if (gridSize % i == 0)
+                return i;
         }
+        return 1;
+    }
 
-        squareSize = maxDivisor;
-        gridSize = gridSize / maxDivisor;
+    // Scale the grid down: a square to its smallest prime factor, a rectangle by the greatest common
+    // divisor of its sides. A tiling of the small grid with every square scaled by squareSize tiles the original.
+    void simplifyGrid() {
+        int divisor = width == height ? largestDivisor(width) : gcd(width, height);
+
+        squareSize = divisor;
+        width /= divisor;
+        height /= divisor;
     }
-};
\ No newline at end of file
+};
+
+using Table = BasicTable<>;
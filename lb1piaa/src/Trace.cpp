@@ -0,0 +1,114 @@
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Buffered output of trace events, one JSON object per line.
+// Lines are collected in a large buffer and written in big blocks, never flushed line by line.
+// Workers of the parallel search share one sink, so appending a line takes a lock.
+class TraceSink {
+
+private:
+
+    FILE* file;
+    vector<char> buffer;
+    size_t used;
+    mutex lock;
+
+public:
+
+    TraceSink(FILE* file, size_t capacity = 1 << 20) : file(file), buffer(capacity), used(0) {}
+
+    ~TraceSink() { flush(); }
+
+    // Append one line (without the newline, it is added here)
+    void writeLine(const char* line, size_t length) {
+        lock_guard<mutex> guard(lock);
+
+        if (used + length + 1 > buffer.size())
+            flushLocked();
+
+        if (length + 1 > buffer.size()) {
+            fwrite(line, 1, length, file);
+            fputc('\n', file);
+            return;
+        }
+
+        copy(line, line + length, buffer.begin() + used);
+        used += length;
+        buffer[used++] = '\n';
+    }
+
+    void flush() {
+        lock_guard<mutex> guard(lock);
+        flushLocked();
+        fflush(file);
+    }
+
+private:
+
+    void flushLocked() {
+        fwrite(buffer.data(), 1, used, file);
+        used = 0;
+    }
+};
+
+// Trace policies of Table.
+// The search calls seed() once, place() for every square it tries (with the task it belongs to,
+// since workers of the parallel search interleave their events) and best() for every new best
+// solution. Coordinates are reported the way printResult prints them: 1-based and scaled back to
+// the original grid, so a trace line can be checked against the printed answer.
+
+// Records nothing, all calls compile away
+struct NoTrace {
+    void attach(TraceSink*) {}
+    void seed(int, int, int) {}
+    void place(unsigned, int, const Square&) {}
+    void best(const Square*, int) {}
+};
+
+// Records the seed and every new best solution
+struct BestTrace {
+
+    TraceSink* sink = nullptr;
+    int scale = 1;
+
+    void attach(TraceSink* traceSink) { sink = traceSink; }
+
+    void seed(int width, int height, int squareSize) {
+        scale = squareSize;
+
+        char line[128];
+        int length = snprintf(line, sizeof(line), "{\"event\":\"seed\",\"width\":%d,\"height\":%d,\"scale\":%d}",
+                              width * squareSize, height * squareSize, squareSize);
+        sink->writeLine(line, length);
+    }
+
+    void place(unsigned, int, const Square&) {}
+
+    void best(const Square* squares, int count) {
+        string line = "{\"event\":\"best\",\"count\":" + to_string(count) + ",\"squares\":[";
+        for (int i = 0; i < count; i++) {
+            if (i > 0)
+                line += ",";
+            line += "[" + to_string(squares[i].x * scale + 1) + "," + to_string(squares[i].y * scale + 1) + ","
+                + to_string(squares[i].size * scale) + "]";
+        }
+        line += "]}";
+        sink->writeLine(line.data(), line.size());
+    }
+};
+
+// Records every square tried by the search in addition to the best solutions
+struct NodeTrace : BestTrace {
+
+    void place(unsigned task, int depth, const Square& square) {
+        char line[160];
+        int length = snprintf(line, sizeof(line),
+                              "{\"event\":\"place\",\"task\":%u,\"depth\":%d,\"x\":%d,\"y\":%d,\"size\":%d}",
+                              task, depth, square.x * scale + 1, square.y * scale + 1, square.size * scale);
+        sink->writeLine(line, length);
+    }
+};
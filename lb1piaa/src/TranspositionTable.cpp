@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// Lower bounds proven for partial tilings, keyed by the Zobrist hash of their occupied cells
+// (the XOR of random keys of the cells, updated square by square with squareKey).
+// The same shape is reached through many placement orders, and the squares still needed to
+// finish it do not depend on the order, so one proof serves all of them.
+// The table has a fixed size: two entries per bucket, and a new entry replaces the one whose
+// proof took less work.
+class TranspositionTable {
+
+private:
+
+    struct Entry {
+        uint64_t key; // hash of the occupied cells, 0 for an empty slot
+        int16_t remaining; // no tiling of the free cells uses fewer squares
+        uint8_t work; // log2 of the nodes it took to prove it
+    };
+
+    vector<Entry> entries;
+    size_t bucketMask;
+
+    int height;
+    // prefix[x * (height + 1) + y] is the XOR of the cell keys in [0, x) x [0, y), shared between copies
+    shared_ptr<const vector<uint64_t>> prefix;
+
+public:
+
+    // Table for a width x height grid that uses at most `bytes` of memory (no table at all below one bucket)
+    TranspositionTable(int width = 0, int height = 0, size_t bytes = 0) : height(height) {
+        size_t buckets = 1;
+        while (buckets * 2 * 2 * sizeof(Entry) <= bytes)
+            buckets *= 2;
+
+        if (2 * sizeof(Entry) <= bytes)
+            entries.assign(buckets * 2, Entry{ 0, 0, 0 });
+        bucketMask = buckets - 1;
+
+        if (enabled())
+            prefix = makePrefix(width, height);
+    }
+
+    bool enabled() const { return !entries.empty(); }
+
+    // XOR of the cell keys covered by a square, four lookups in the prefix table.
+    // Placing or removing the square flips the hash of the occupied cells by this value.
+    uint64_t squareKey(int x, int y, int length) const {
+        const vector<uint64_t>& table = *prefix;
+        int stride = height + 1;
+        return table[(x + length) * stride + y + length] ^ table[x * stride + y + length]
+            ^ table[(x + length) * stride + y] ^ table[x * stride + y];
+    }
+
+    // Look up the bound proven for the shape, returns false if it is unknown
+    bool find(uint64_t hash, int& remaining) const {
+        uint64_t key = hash | 1;
+        const Entry* bucket = &entries[(hash >> 1 & bucketMask) * 2];
+
+        for (int i = 0; i < 2; i++) {
+            if (bucket[i].key == key) {
+                remaining = bucket[i].remaining;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Remember that the free cells of the shape need at least `remaining` squares
+    void store(uint64_t hash, int remaining, long long nodes) {
+        uint64_t key = hash | 1;
+        Entry* bucket = &entries[(hash >> 1 & bucketMask) * 2];
+
+        int work = 0;
+        while (work < 63 && (1LL << (work + 1)) <= nodes)
+            work++;
+
+        // Refresh the entry of the same shape, otherwise evict the cheaper one.
+        Entry* slot = bucket[0].key == key || (bucket[1].key != key && bucket[0].work <= bucket[1].work)
+            ? &bucket[0] : &bucket[1];
+
+        if (slot->key == key && slot->remaining > remaining)
+            return;
+
+        *slot = Entry{ key, int16_t(remaining), uint8_t(work) };
+    }
+
+private:
+
+    // Random key of a cell (splitmix64 of its index), the same for every run
+    static uint64_t cellKey(int x, int y) {
+        uint64_t z = uint64_t(x * 64 + y + 1) * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    static shared_ptr<const vector<uint64_t>> makePrefix(int width, int height) {
+        int stride = height + 1;
+        auto table = make_shared<vector<uint64_t>>((width + 1) * stride, 0);
+
+        for (int x = 1; x <= width; x++) {
+            for (int y = 1; y <= height; y++) {
+                (*table)[x * stride + y] = cellKey(x - 1, y - 1) ^ (*table)[(x - 1) * stride + y]
+                    ^ (*table)[x * stride + y - 1] ^ (*table)[(x - 1) * stride + y - 1];
+            }
+        }
+        return table;
+    }
+};
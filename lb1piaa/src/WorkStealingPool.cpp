@@ -0,0 +1,82 @@
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Fixed set of worker threads with one task queue per worker.
+// A worker takes tasks from the front of its own queue (lowest index first) and,
+// once it runs dry, steals from the back of the other queues.
+class WorkStealingPool {
+
+private:
+
+    struct Queue {
+        mutex lock;
+        deque<int> tasks;
+    };
+
+    int threadCount;
+
+public:
+
+    WorkStealingPool(int threadCount) : threadCount(threadCount < 1 ? 1 : threadCount) {}
+
+    int size() const { return threadCount; }
+
+    // Run job(worker, task) for every task in [0, taskCount) exactly once and wait for all of them.
+    // The worker index is in [0, size()) and lets the job use per-thread state.
+    void run(int taskCount, const function<void(int, int)>& job) {
+
+        vector<Queue> queues(threadCount);
+
+        // Deal the tasks out round robin, so early tasks start on every worker first.
+        for (int task = 0; task < taskCount; task++)
+            queues[task % threadCount].tasks.push_back(task);
+
+        vector<thread> workers;
+        for (int worker = 0; worker < threadCount; worker++) {
+            workers.emplace_back([&, worker]() {
+                int task;
+                while (takeOwn(queues[worker], task) || steal(queues, worker, task))
+                    job(worker, task);
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+private:
+
+    // Pop the next task from the front of the worker's own queue
+    static bool takeOwn(Queue& queue, int& task) {
+        lock_guard<mutex> guard(queue.lock);
+        if (queue.tasks.empty())
+            return false;
+
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    // Pop a task from the back of another worker's queue.
+    // No tasks are created while running, so empty queues everywhere mean the work is done.
+    static bool steal(vector<Queue>& queues, int thief, int& task) {
+        int count = queues.size();
+
+        for (int offset = 1; offset < count; offset++) {
+            Queue& victim = queues[(thief + offset) % count];
+
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+};
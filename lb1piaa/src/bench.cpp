@@ -0,0 +1,132 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Table.cpp"
+
+using namespace std;
+
+// Benchmark of the squaring solver: solves every grid size in a range with an instrumented
+// Table and prints one record per size as CSV (default) or JSON.
+// Every size runs in a child process, so the peak memory is that of the size alone.
+//
+// Command line:
+//   --from N / --to N  range of grid sizes (2..40 by default)
+//   --json             print a JSON array instead of CSV
+//   -t, -b, -w, -m, --deepening  solver options as in main
+// The solution cache is never used, every size is searched.
+
+struct BenchOptions {
+    int from = 2;
+    int to = 40;
+    bool json = false;
+    int threadCount = 1;
+    const LowerBound* bound = findBound("area");
+    bool iterativeDeepening = false;
+    int warmStartRuns = 32;
+    size_t tableMegabytes = 0;
+};
+
+// Solve one grid size and print its record
+void benchSize(int gridSize, const BenchOptions& options) {
+
+    BasicTable<SearchStats> table(gridSize, options.threadCount);
+    table.setBound(options.bound);
+    table.setIterativeDeepening(options.iterativeDeepening);
+    table.setWarmStart(options.warmStartRuns);
+    table.setTableMemory(options.tableMegabytes << 20);
+
+    auto start = chrono::steady_clock::now();
+    table.placeSquares();
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    const SearchStats& stats = table.stats();
+
+    if (options.json) {
+        printf("{\"n\": %d, \"simplified\": %d, \"squares\": %d, \"wall_ms\": %.3f, \"nodes\": %lld",
+               gridSize, table.simplifiedSize(), table.squareCount(), milliseconds, stats.nodes);
+        for (int reason = 0; reason < PRUNE_REASONS; reason++)
+            printf(", \"prune_%s\": %lld", PRUNE_REASON_NAMES[reason], stats.prunes[reason]);
+        printf(", \"max_depth\": %d, \"peak_kb\": %ld}", stats.maxDepth, usage.ru_maxrss);
+    }
+    else {
+        printf("%d,%d,%d,%.3f,%lld", gridSize, table.simplifiedSize(), table.squareCount(), milliseconds, stats.nodes);
+        for (int reason = 0; reason < PRUNE_REASONS; reason++)
+            printf(",%lld", stats.prunes[reason]);
+        printf(",%d,%ld\n", stats.maxDepth, usage.ru_maxrss);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--from" && i + 1 < argc)
+            options.from = stoi(argv[++i]);
+        else if (option == "--to" && i + 1 < argc)
+            options.to = stoi(argv[++i]);
+        else if (option == "--json")
+            options.json = true;
+        else if ((option == "-t" || option == "--threads") && i + 1 < argc)
+            options.threadCount = stoi(argv[++i]);
+        else if ((option == "-b" || option == "--bound") && i + 1 < argc)
+            options.bound = findBound(argv[++i]);
+        else if (option == "--deepening")
+            options.iterativeDeepening = true;
+        else if ((option == "-w" || option == "--warm-start") && i + 1 < argc)
+            options.warmStartRuns = stoi(argv[++i]);
+        else if ((option == "-m" || option == "--memory") && i + 1 < argc)
+            options.tableMegabytes = stoul(argv[++i]);
+    }
+
+    if (options.bound == nullptr) {
+        cerr << "Unknown bound" << endl;
+        return 1;
+    }
+    if (options.threadCount == 0)
+        options.threadCount = thread::hardware_concurrency();
+
+    if (options.json)
+        printf("[");
+    else {
+        printf("n,simplified,squares,wall_ms,nodes");
+        for (int reason = 0; reason < PRUNE_REASONS; reason++)
+            printf(",prune_%s", PRUNE_REASON_NAMES[reason]);
+        printf(",max_depth,peak_kb\n");
+    }
+    fflush(stdout);
+
+    bool first = true;
+    for (int gridSize = options.from; gridSize <= options.to; gridSize++) {
+        if (!Table::isSupported(gridSize))
+            continue;
+
+        if (options.json) {
+            printf(first ? "\n  " : ",\n  ");
+            fflush(stdout);
+        }
+        first = false;
+
+        pid_t child = fork();
+        if (child == 0) {
+            benchSize(gridSize, options);
+            _exit(0);
+        }
+
+        int status = 0;
+        waitpid(child, &status, 0);
+    }
+
+    if (options.json)
+        printf("\n]\n");
+
+    return 0;
+}
@@ -1,16 +1,129 @@
+#include <cstdio>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include "Table.cpp"
 
 using namespace std;
 
-int main() {
+struct Options {
+    int threadCount = 1;
+    string cachePath;
+    bool useCache = true;
+    const LowerBound* bound = findBound("area");
+    bool iterativeDeepening = false;
+    bool printNodes = false;
+    int warmStartRuns = 32;
+    size_t tableMegabytes = 0;
+    string traceLevel = "none";
+    string tracePath;
+};
 
-    int gridSize;
-    cin >> gridSize;
+// Solve the grid with the given trace policy and print the tiling
+template <class Trace>
+void solve(int width, int height, const Options& options, TraceSink* sink) {
 
-    Table table(gridSize);
+    SolutionCache cache(options.cachePath);
+
+    BasicTable<NoStats, Trace> table(width, height, options.threadCount, options.useCache ? &cache : nullptr);
+    table.setBound(options.bound);
+    table.setIterativeDeepening(options.iterativeDeepening);
+    table.setWarmStart(options.warmStartRuns);
+    table.setTableMemory(options.tableMegabytes << 20);
+    table.setTrace(sink);
     table.placeSquares();
     table.printResult();
 
+    if (options.printNodes)
+        cerr << "nodes: " << table.nodeCount() << endl;
+}
+
+int main(int argc, char* argv[]) {
+
+    // Command line:
+    //   -t N       number of worker threads, 0 means one per hardware thread
+    //   -c FILE    file that keeps the tilings found by the search between runs
+    //   --no-cache always search, even for grids with a known tiling
+    //   -b NAME    lower bound used for pruning: area or segments
+    //   --deepening search for k squares with growing k instead of improving the best solution
+    //   --nodes    print the number of expanded nodes to stderr
+    //   -w N       number of short randomized searches run before the exact one, 0 to start without an incumbent
+    //   -m MB      memory of the transposition tables, 0 (the default) to run without them
+    //   --trace LEVEL  write the search steps as JSON lines: none (default), best (improving solutions)
+    //                  or nodes (every square tried as well)
+    //   --trace-file FILE  where the trace goes, stderr by default
+    // Input: the side N of a square grid, or "N M" for a rectangle N columns wide and M rows high.
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if ((option == "-t" || option == "--threads") && i + 1 < argc)
+            options.threadCount = stoi(argv[++i]);
+        else if ((option == "-c" || option == "--cache") && i + 1 < argc)
+            options.cachePath = argv[++i];
+        else if (option == "--no-cache")
+            options.useCache = false;
+        else if ((option == "-b" || option == "--bound") && i + 1 < argc)
+            options.bound = findBound(argv[++i]);
+        else if (option == "--deepening")
+            options.iterativeDeepening = true;
+        else if (option == "--nodes")
+            options.printNodes = true;
+        else if ((option == "-w" || option == "--warm-start") && i + 1 < argc)
+            options.warmStartRuns = stoi(argv[++i]);
+        else if ((option == "-m" || option == "--memory") && i + 1 < argc)
+            options.tableMegabytes = stoul(argv[++i]);
+        else if (option == "--trace" && i + 1 < argc)
+            options.traceLevel = argv[++i];
+        else if (option == "--trace-file" && i + 1 < argc)
+            options.tracePath = argv[++i];
+    }
+
+    if (options.bound == nullptr) {
+        cout << "Unknown bound" << endl;
+        return 1;
+    }
+    if (options.traceLevel != "none" && options.traceLevel != "best" && options.traceLevel != "nodes") {
+        cout << "Unknown trace level" << endl;
+        return 1;
+    }
+    if (options.threadCount == 0)
+        options.threadCount = thread::hardware_concurrency();
+
+    string line;
+    getline(cin, line);
+    istringstream input(line);
+
+    int width = 0;
+    input >> width;
+    int height = width;
+    input >> height;
+
+    if (!Table::isSupported(width, height)) {
+        cout << "Unsupported grid size" << endl;
+        return 1;
+    }
+
+    if (options.traceLevel == "none") {
+        solve<NoTrace>(width, height, options, nullptr);
+        return 0;
+    }
+
+    FILE* traceFile = options.tracePath.empty() ? stderr : fopen(options.tracePath.c_str(), "w");
+    if (traceFile == nullptr) {
+        cout << "Cannot open the trace file" << endl;
+        return 1;
+    }
+
+    {
+        TraceSink sink(traceFile);
+        if (options.traceLevel == "best")
+            solve<BestTrace>(width, height, options, &sink);
+        else
+            solve<NodeTrace>(width, height, options, &sink);
+    }
+
+    if (traceFile != stderr)
+        fclose(traceFile);
+
     return 0;
-}
\ No newline at end of file
+}